@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+// FIFO queue of cities whose neighborhood still has to be examined by a local search, combined with
+// don't-look bits: a city is in the queue exactly when its bit is off, so pushing a queued city is a no-op.
+// Operators push the endpoints of every tour edge they change, everything else stays asleep.
+class ActiveCityQueue
+{
+	std::vector<uint32_t> m_queue;
+	std::vector<uint8_t> m_isQueued;
+	uint32_t m_head = 0;
+	uint32_t m_size = 0;
+
+public:
+	// Resets the queue for numberOfCities cities, either with all of them active in index order or empty
+	void reset(uint32_t numberOfCities, bool activateAll = true);
+
+	bool isEmpty() const { return m_size == 0; };
+	uint32_t size() const { return m_size; };
+	bool isQueued(uint32_t city) const { return m_isQueued[city] != 0; };
+
+	void push(uint32_t city)
+	{
+		if (m_isQueued[city])
+		{
+			return;
+		}
+		m_isQueued[city] = 1;
+
+		uint32_t tail = m_head + m_size;
+		if (tail >= m_queue.size())
+		{
+			tail -= m_queue.size();
+		}
+		m_queue[tail] = city;
+		++m_size;
+	};
+
+	uint32_t pop()
+	{
+		const uint32_t city = m_queue[m_head];
+		m_isQueued[city] = 0;
+
+		if (++m_head == m_queue.size())
+		{
+			m_head = 0;
+		}
+		--m_size;
+
+		return city;
+	};
+};
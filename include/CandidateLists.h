@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CityCoordinates.h"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+// Candidate neighbors of every city in compressed sparse row layout: the candidates of city c are
+// m_neighbors[m_offsets[c] .. m_offsets[c + 1]), ordered by increasing distance from c.
+class CandidateLists
+{
+	std::vector<uint32_t> m_offsets;
+	std::vector<uint32_t> m_neighbors;
+
+public:
+	static constexpr uint32_t DEFAULT_NUMBER_OF_NEIGHBORS = 10;
+
+public:
+	// Builds the k nearest neighbor lists of all cities with a kd-tree, queries run on numberOfThreads threads
+	void buildNearestNeighbors(const CityCoordinates& coordinates, uint32_t k, unsigned int numberOfThreads);
+	// Builds the lists from the Delaunay triangulation: the candidates of a city are the cities it shares an edge with,
+	// six on average. They almost always include the edges of an optimal tour and are fewer than nearest neighbor lists.
+	void buildDelaunayNeighbors(const CityCoordinates& coordinates);
+	void clear();
+
+	uint32_t getNumberOfCities() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; };
+	bool isEmpty() const { return m_neighbors.empty(); };
+
+	std::span<const uint32_t> getNeighbors(uint32_t city) const
+	{
+		return std::span<const uint32_t>(m_neighbors.data() + m_offsets[city], m_offsets[city + 1] - m_offsets[city]);
+	};
+
+	const std::vector<uint32_t>& getOffsets() const { return m_offsets; };
+	const std::vector<uint32_t>& getNeighborArray() const { return m_neighbors; };
+};
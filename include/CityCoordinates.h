@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Point2D.h"
+#include "AlignedAllocator.h"
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+// How the distance between two cities is measured. The rounded modes match the TSPLIB EUC_2D (nint), CEIL_2D and ATT
+// edge weights and only produce integers, so route lengths in them are exact (as long as single distances stay below 2^24).
+enum DistanceMode
+{
+	EUCLIDEAN,
+	ROUNDED_EUCLIDEAN,
+	CEILED_EUCLIDEAN,
+	// TSPLIB ATT: nint(r) rounded up when below r, for r = sqrt((dx^2 + dy^2) / 10), which is ceil(r)
+	PSEUDO_EUCLIDEAN,
+
+};
+
+// Structure-of-arrays store of city coordinates, the only data the solving algorithms read per city.
+// Both arrays are 32-byte aligned so they can be consumed directly by SIMD kernels.
+class CityCoordinates
+{
+public:
+	static constexpr std::size_t ALIGNMENT = 32;
+	using CoordinateArray = std::vector<float, AlignedAllocator<float, ALIGNMENT>>;
+
+private:
+	CoordinateArray m_xs;
+	CoordinateArray m_ys;
+	DistanceMode m_distanceMode = EUCLIDEAN;
+
+public:
+	void clear();
+	void reserve(uint32_t numberOfCities);
+	void addCity(float x, float y);
+	void resize(uint32_t numberOfCities);
+	void setCity(uint32_t city, float x, float y) { m_xs[city] = x; m_ys[city] = y; };
+
+	uint32_t size() const { return m_xs.size(); };
+	bool isEmpty() const { return m_xs.empty(); };
+
+	DistanceMode getDistanceMode() const { return m_distanceMode; };
+	void setDistanceMode(DistanceMode distanceMode) { m_distanceMode = distanceMode; };
+	bool isIntegerDistanceMode() const { return m_distanceMode != EUCLIDEAN; };
+
+	float getX(uint32_t city) const { return m_xs[city]; };
+	float getY(uint32_t city) const { return m_ys[city]; };
+	Point2D getPoint(uint32_t city) const { return Point2D(m_xs[city], m_ys[city]); };
+
+	const float* getXs() const { return m_xs.data(); };
+	const float* getYs() const { return m_ys.data(); };
+
+	float getDistance(uint32_t firstCity, uint32_t secondCity) const
+	{
+		if (m_distanceMode == EUCLIDEAN)
+		{
+			return std::sqrt(getSquaredDistance(firstCity, secondCity));
+		}
+
+		// Rounding is done in double like the TSPLIB reference, so .5 boundaries round the same way
+		const double dx = static_cast<double>(m_xs[firstCity]) - m_xs[secondCity];
+		const double dy = static_cast<double>(m_ys[firstCity]) - m_ys[secondCity];
+		if (m_distanceMode == PSEUDO_EUCLIDEAN)
+		{
+			return static_cast<float>(std::ceil(std::sqrt((dx * dx + dy * dy) / 10.0)));
+		}
+		const double distance = std::sqrt(dx * dx + dy * dy);
+		return static_cast<float>(m_distanceMode == ROUNDED_EUCLIDEAN ? std::floor(distance + 0.5) : std::ceil(distance));
+	};
+	float getSquaredDistance(uint32_t firstCity, uint32_t secondCity) const
+	{
+		const float dx = m_xs[firstCity] - m_xs[secondCity];
+		const float dy = m_ys[firstCity] - m_ys[secondCity];
+		return dx * dx + dy * dy;
+	};
+};
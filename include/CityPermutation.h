@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CityCoordinates.h"
+#include "Route.h"
+
+#include <vector>
+#include <cstdint>
+
+// Renumbering of the cities: city i of the permuted coordinates is city getOriginalCity(i) of the original ones.
+// Solving on coordinates renumbered in Hilbert order keeps cities that are close in space close in memory;
+// routes are translated at the boundary, so callers only ever see the original numbering.
+class CityPermutation
+{
+	std::vector<uint32_t> m_originalCities;
+	std::vector<uint32_t> m_permutedCities;
+
+public:
+	void buildHilbertOrder(const CityCoordinates& coordinates);
+	void clear();
+
+	bool isEmpty() const { return m_originalCities.empty(); };
+	uint32_t getOriginalCity(uint32_t permutedCity) const { return m_originalCities[permutedCity]; };
+	uint32_t getPermutedCity(uint32_t originalCity) const { return m_permutedCities[originalCity]; };
+
+	// Writes the original coordinates in permuted order, the distance mode is kept
+	void permuteCoordinates(const CityCoordinates& original, CityCoordinates& permuted) const;
+	void toPermutedRoute(const Route& original, Route& permuted) const;
+	void toOriginalRoute(const Route& permuted, Route& original) const;
+};
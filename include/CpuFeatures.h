@@ -0,0 +1,33 @@
+#pragma once
+
+// SIMD kernels are compiled for x86-64 only, elsewhere the scalar code is used
+#if defined(_M_X64) || defined(__x86_64__)
+#define SIMD_KERNELS_X86 1
+#endif
+
+// Functions using wider instructions than the build targets are marked so GCC and Clang accept their intrinsics,
+// MSVC accepts them anywhere. They may only be called after getInstructionSet confirmed support.
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#endif
+
+// Ordered from narrowest to widest, so a kernel can use any set up to the supported one
+enum InstructionSet
+{
+	SCALAR,
+	SSE41,
+	AVX2,
+
+};
+
+class CpuFeatures
+{
+public:
+	// Widest instruction set supported by both the processor and the operating system, detected once
+	static InstructionSet getInstructionSet();
+	static const char* getInstructionSetName(InstructionSet instructionSet);
+};
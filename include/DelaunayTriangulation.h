@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CityCoordinates.h"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+// Delaunay triangulation of the cities by a sweep from the center outwards (the Delaunator algorithm): cities are added in
+// order of distance from a seed triangle, each one is connected to the convex hull edges it sees and the new triangles are
+// made Delaunay by edge flips. A hash of the hull by angle finds the visible edges, so the expected time is O(n log n).
+// All decisions use the exact predicates of GeometricPredicates. Cities sharing a position are triangulated once, the
+// copies are only connected to it; collinear cities form a path. The edges are exported as an adjacency in compressed rows.
+class DelaunayTriangulation
+{
+	// Triangle t has the cities m_triangles[3t .. 3t + 2] in counterclockwise order. Halfedge e runs from m_triangles[e]
+	// to the next city of its triangle, m_halfedges[e] is the opposite halfedge in the neighboring triangle.
+	std::vector<uint32_t> m_triangles;
+	std::vector<uint32_t> m_halfedges;
+
+	std::vector<uint32_t> m_offsets;
+	std::vector<uint32_t> m_neighbors;
+
+	// Convex hull during the sweep as a counterclockwise linked cycle, each city with the halfedge of its outgoing hull edge
+	const CityCoordinates* m_coordinates = nullptr;
+	std::vector<uint32_t> m_hullPrevious;
+	std::vector<uint32_t> m_hullNext;
+	std::vector<uint32_t> m_hullHalfedges;
+	std::vector<uint32_t> m_hullHash;
+	uint32_t m_hullStart = 0;
+	double m_centerX = 0.0;
+	double m_centerY = 0.0;
+	std::vector<uint32_t> m_flipStack;
+
+public:
+	static constexpr uint32_t INVALID_HALFEDGE = UINT32_MAX;
+
+public:
+	void build(const CityCoordinates& coordinates);
+
+	uint32_t getNumberOfTriangles() const { return m_triangles.size() / 3; };
+	const std::vector<uint32_t>& getTriangles() const { return m_triangles; };
+	const std::vector<uint32_t>& getHalfedges() const { return m_halfedges; };
+
+	// Cities sharing a triangulation edge with city, in no particular order
+	std::span<const uint32_t> getNeighbors(uint32_t city) const
+	{
+		return std::span<const uint32_t>(m_neighbors.data() + m_offsets[city], m_offsets[city + 1] - m_offsets[city]);
+	};
+	const std::vector<uint32_t>& getOffsets() const { return m_offsets; };
+	const std::vector<uint32_t>& getNeighborArray() const { return m_neighbors; };
+
+private:
+	uint32_t addTriangle(uint32_t first, uint32_t second, uint32_t third, uint32_t firstOpposite, uint32_t secondOpposite, uint32_t thirdOpposite);
+	void link(uint32_t halfedge, uint32_t opposite);
+	// Flips the edge of halfedge and the edges behind it until all are Delaunay, returns the halfedge leaving the new city
+	uint32_t legalize(uint32_t halfedge);
+	uint32_t getHullHashKey(float x, float y) const;
+	// Whether the hull edge from city first to city second is seen from (x, y), i.e. the point lies strictly right of it
+	bool isVisible(uint32_t first, uint32_t second, float x, float y) const;
+	void buildAdjacency(const std::vector<uint32_t>& extraEdges);
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+// Union-find over the cities with union by size and path halving, used by the constructions that join fragments
+class DisjointSets
+{
+	std::vector<uint32_t> m_parents;
+	std::vector<uint32_t> m_sizes;
+
+public:
+	// Puts each of numberOfElements elements into a set of its own
+	void reset(uint32_t numberOfElements);
+
+	uint32_t find(uint32_t element)
+	{
+		while (m_parents[element] != element)
+		{
+			m_parents[element] = m_parents[m_parents[element]];
+			element = m_parents[element];
+		}
+		return element;
+	};
+	// Merges the sets of both elements, returns false if they already were in the same set
+	bool unite(uint32_t first, uint32_t second);
+	uint32_t getSetSize(uint32_t element) { return m_sizes[find(element)]; };
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+// xoshiro256** generator seeded through SplitMix64. A few cycles per number and a period of 2^256 - 1, for the
+// metaheuristics that draw a random number per move evaluation. Equal seeds give equal sequences on every platform.
+class FastRandom
+{
+	uint64_t m_state[4];
+
+public:
+	explicit FastRandom(uint64_t seed)
+	{
+		for (uint64_t& word : m_state)
+		{
+			seed += GOLDEN_GAMMA;
+			word = mix(seed);
+		}
+	};
+
+	// Seed of the independent stream index of seed. Unlike seed + index it does not run into the seed + task ranges
+	// the parallel metaheuristics derive from every seed.
+	static uint64_t deriveSeed(uint64_t seed, uint64_t index) { return mix(seed + (index + 1) * GOLDEN_GAMMA); };
+
+	uint64_t next()
+	{
+		const uint64_t result = rotateLeft(m_state[1] * 5, 7) * 9;
+		const uint64_t shifted = m_state[1] << 17;
+
+		m_state[2] ^= m_state[0];
+		m_state[3] ^= m_state[1];
+		m_state[1] ^= m_state[2];
+		m_state[0] ^= m_state[3];
+		m_state[2] ^= shifted;
+		m_state[3] = rotateLeft(m_state[3], 45);
+
+		return result;
+	};
+	// Uniform in [0, bound) by scaling the upper 32 bits instead of a division, bound must be positive
+	uint32_t nextBelow(uint32_t bound) { return static_cast<uint32_t>(((next() >> 32) * bound) >> 32); };
+	// Uniform in [0, 1)
+	float nextFloat() { return static_cast<float>(next() >> 40) * 0x1.0p-24f; };
+	double nextDouble() { return static_cast<double>(next() >> 11) * 0x1.0p-53; };
+
+private:
+	static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ull;
+
+	// SplitMix64 output function
+	static uint64_t mix(uint64_t value)
+	{
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+		return value ^ (value >> 31);
+	};
+	static uint64_t rotateLeft(uint64_t value, int shift) { return (value << shift) | (value >> (64 - shift)); };
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+// Exact sign tests on float coordinates with adaptive precision: the determinant is evaluated in double precision and
+// its sign is taken when it exceeds a forward error bound, which decides all but nearly degenerate inputs. Only those
+// are evaluated again exactly as a sum of floating point expansions (Shewchuk's robust predicates).
+class GeometricPredicates
+{
+public:
+	// 1 when a, b, c are in counterclockwise order, -1 when clockwise, 0 when collinear
+	static int orientation(float ax, float ay, float bx, float by, float cx, float cy);
+	// 1 when d lies inside the circle through a, b, c in counterclockwise order, -1 outside of it, 0 on it
+	static int inCircle(float ax, float ay, float bx, float by, float cx, float cy, float dx, float dy);
+};
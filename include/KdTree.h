@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CityCoordinates.h"
+
+#include <vector>
+#include <cstdint>
+
+// 2D kd-tree over the cities of a CityCoordinates store. Leaves hold up to LEAF_SIZE cities, 
+// inner nodes split their cities at the median of the coordinate with the larger spread.
+// Cities can also be removed to answer nearest-remaining queries: every node counts the cities left below it,
+// and a leaf keeps its remaining cities at the front of its range, so empty subtrees are skipped.
+class KdTree
+{
+	struct Node
+	{
+		uint32_t begin;
+		uint32_t end;
+		uint32_t lowerChild;
+		uint32_t upperChild;
+		uint32_t parent;
+		uint32_t numberOfRemaining;
+		float splitValue;
+		uint8_t splitDimension;
+	};
+
+	const CityCoordinates* m_coordinates = nullptr;
+	std::vector<Node> m_nodes;
+	std::vector<uint32_t> m_cities;
+	// Index of each city in m_cities and the leaf holding it
+	std::vector<uint32_t> m_positions;
+	std::vector<uint32_t> m_leaves;
+
+public:
+	static constexpr uint32_t LEAF_SIZE = 8;
+	static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+	static constexpr uint32_t INVALID_CITY = UINT32_MAX;
+
+public:
+	// The tree keeps a pointer to coordinates, which must outlive it and not change
+	void build(const CityCoordinates& coordinates);
+
+	// Writes up to k nearest other cities of the given city to neighbors (closest first) and returns their count.
+	// squaredDistances receives the matching squared distances, both buffers must hold k entries.
+	uint32_t findNearestNeighbors(uint32_t city, uint32_t k, uint32_t* neighbors, float* squaredDistances) const;
+
+	// Makes every city remaining again, build starts with all of them remaining
+	void resetRemaining();
+	// Removes a remaining city from the nearest-remaining queries, neighbor queries still see it
+	void removeCity(uint32_t city);
+	// Makes a removed city remaining again
+	void restoreCity(uint32_t city);
+	bool isRemaining(uint32_t city) const { return m_positions[city] < m_nodes[m_leaves[city]].begin + m_nodes[m_leaves[city]].numberOfRemaining; };
+	// Remaining city with the smallest squared distance to (x, y), INVALID_CITY when none remain
+	uint32_t findNearestRemaining(float x, float y) const;
+
+private:
+	uint32_t buildNode(uint32_t begin, uint32_t end, uint32_t parent);
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// Calls function(index) for every index in [begin, end) on up to numberOfThreads threads.
+// Work is handed out in chunks from a shared counter, so uneven per-index costs still balance out.
+template <typename Function>
+void parallelFor(uint32_t begin, uint32_t end, unsigned int numberOfThreads, Function function)
+{
+	const uint32_t CHUNK_SIZE = 1024;
+
+	if (end <= begin)
+	{
+		return;
+	}
+
+	const uint32_t numberOfChunks = (end - begin + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	numberOfThreads = std::max(1u, std::min(numberOfThreads, numberOfChunks));
+
+	std::atomic<uint32_t> nextChunk = 0;
+	auto worker = [&]()
+		{
+			for (uint32_t chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+			{
+				const uint32_t chunkBegin = begin + chunk * CHUNK_SIZE;
+				const uint32_t chunkEnd = std::min(end, chunkBegin + CHUNK_SIZE);
+				for (uint32_t index = chunkBegin; index < chunkEnd; ++index)
+				{
+					function(index);
+				}
+			}
+		};
+
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < numberOfThreads; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
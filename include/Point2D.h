@@ -1,17 +1,9 @@
 #pragma once
 
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include <iostream>
-
 class Point2D
 {
 	float m_x;
 	float m_y;
-	glm::vec3 m_color;
-	glm::vec3 m_outgoingLineColor;
 
 public:
 	Point2D(float x, float y);
@@ -23,10 +15,4 @@ public:
 	void setX(float x) { m_x = x; };
 	float getY() const { return m_y; };
 	void setY(float y) { m_y = y; };
-
-	glm::vec3 getColor() const { return m_color; };
-	void setColor(glm::vec3 color) { m_color = color; };
-	glm::vec3 getOutgoingLineColor() const { return m_outgoingLineColor; };
-	void setOutgoingLineColor(glm::vec3 color) { m_outgoingLineColor = color; };
 };
-
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+// Tour stored as a sequence of city indices together with its inverse (position of each city in the tour).
+// The tour is cyclic, the edge closing the route from the last to the first city is implicit.
+class Route
+{
+	std::vector<uint32_t> m_cities;
+	std::vector<uint32_t> m_positions;
+
+public:
+	static constexpr uint32_t INVALID_POSITION = UINT32_MAX;
+	static constexpr uint32_t MAX_MOVED_SEGMENT_LENGTH = 3;
+
+public:
+	void reset(uint32_t numberOfCities);
+	void append(uint32_t city);
+
+	uint32_t size() const { return m_cities.size(); };
+	uint32_t getNumberOfCities() const { return m_positions.size(); };
+	bool isEmpty() const { return m_cities.empty(); };
+	bool isComplete() const { return !m_positions.empty() && m_cities.size() == m_positions.size(); };
+
+	uint32_t at(uint32_t position) const { return m_cities[position]; };
+	uint32_t getPosition(uint32_t city) const { return m_positions[city]; };
+	bool contains(uint32_t city) const { return m_positions[city] != INVALID_POSITION; };
+
+	uint32_t next(uint32_t city) const 
+	{
+		const uint32_t position = m_positions[city] + 1;
+		return m_cities[position == m_cities.size() ? 0 : position];
+	};
+	uint32_t prev(uint32_t city) const 
+	{
+		const uint32_t position = m_positions[city];
+		return m_cities[position == 0 ? m_cities.size() - 1 : position - 1];
+	};
+	// Whether city b lies on the path walking forward from city a to city c, both ends included
+	bool between(uint32_t a, uint32_t b, uint32_t c) const
+	{
+		const uint32_t positionA = m_positions[a];
+		const uint32_t positionB = m_positions[b];
+		const uint32_t positionC = m_positions[c];
+		if (positionA <= positionC)
+		{
+			return positionA <= positionB && positionB <= positionC;
+		}
+		return positionB >= positionA || positionB <= positionC;
+	};
+
+	// Reverses the cities at positions [firstPosition, lastPosition] (inclusive) and updates their positions
+	void reverse(uint32_t firstPosition, uint32_t lastPosition);
+	// Reverses the cyclic segment walking forward from firstPosition to lastPosition, which may wrap around the end.
+	// Reversing the complement of a segment yields the same cyclic tour, so the shorter of the two is reversed.
+	void reverseCyclic(uint32_t firstPosition, uint32_t lastPosition);
+	// Reverses the path walking forward from city first to city last
+	void flip(uint32_t first, uint32_t last) { reverseCyclic(m_positions[first], m_positions[last]); };
+
+	// Moves the segment of segmentLength (at most MAX_MOVED_SEGMENT_LENGTH) cities starting at segmentFirstPosition
+	// between targetCity and the city following it, optionally reversed. Neither of those two cities may be in the segment.
+	// The cities in between are shifted along whichever side of the cycle is shorter.
+	void moveSegment(uint32_t segmentFirstPosition, uint32_t segmentLength, uint32_t targetCity, bool isReversed);
+
+	const std::vector<uint32_t>& getCities() const { return m_cities; };
+};
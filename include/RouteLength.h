@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CityCoordinates.h"
+#include "Route.h"
+#include "TwoLevelTour.h"
+
+#include <cstdint>
+#include <cmath>
+
+// Length of a route as the algorithms update it move by move. In the integer distance modes every delta is an
+// integer and the length is kept exactly in an int64. In the EUCLIDEAN mode it is kept in a double that is re-summed
+// from the route every RESUMMATION_INTERVAL updates, so rounding errors of millions of deltas cannot pile up.
+class RouteLength
+{
+	int64_t m_integerLength = 0;
+	double m_length = 0.0;
+	bool m_isInteger = false;
+	uint32_t m_numberOfUpdates = 0;
+
+public:
+	static constexpr uint32_t RESUMMATION_INTERVAL = 1 << 16;
+
+public:
+	// Starts from an empty route measured in the distance mode of coordinates
+	void reset(const CityCoordinates& coordinates);
+	// Sums the route from scratch, the closing edge is only included once the route is complete
+	void recompute(const CityCoordinates& coordinates, const Route& route);
+	void recompute(const CityCoordinates& coordinates, const TwoLevelTour& tour);
+
+	void add(double delta)
+	{
+		if (m_isInteger)
+		{
+			m_integerLength += std::llround(delta);
+		}
+		else
+		{
+			m_length += delta;
+		}
+		++m_numberOfUpdates;
+	};
+
+	// Re-sums the length when enough updates were accumulated, call after applying a move to a Route or TwoLevelTour
+	template <typename Tour>
+	void resynchronize(const CityCoordinates& coordinates, const Tour& tour)
+	{
+		if (!m_isInteger && m_numberOfUpdates >= RESUMMATION_INTERVAL)
+		{
+			recompute(coordinates, tour);
+		}
+	};
+
+	bool isInteger() const { return m_isInteger; };
+	double get() const { return m_isInteger ? static_cast<double>(m_integerLength) : m_length; };
+	int64_t getInteger() const { return m_isInteger ? m_integerLength : std::llround(m_length); };
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Budgets and parameters of the metaheuristics, the constructions and local searches ignore them
+struct SearchSettings
+{
+	// Runs with equal settings and seeds make the same moves, as long as no deadline cuts them short
+	uint64_t seed = 1;
+	// The metaheuristics fit their schedule into the time left until the deadline and stop there
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+	// Threads of the parallel metaheuristics, 0 for one per hardware thread
+	unsigned int numberOfWorkerThreads = 0;
+
+	// Move evaluations of simulated annealing, per replica in parallel tempering, 0 for DEFAULT_ANNEALING_MOVES_PER_CITY per city
+	uint64_t annealingIterations = 0;
+	// The temperature falls geometrically from the start to the end temperature over the iterations or the time until the
+	// deadline, whichever runs out first. 0 derives the start temperature from the tour and the end one from the start.
+	double annealingStartTemperature = 0.0;
+	double annealingEndTemperature = 0.0;
+
+	// Kicks of iterated local search, 0 for DEFAULT_ILS_KICKS_PER_CITY per city
+	uint64_t localSearchKicks = 0;
+
+	// Individuals of the genetic algorithm, 0 for DEFAULT_GA_POPULATION_SIZE, and its generations, 0 to run until a
+	// generation improves no individual
+	uint32_t populationSize = 0;
+	uint64_t geneticGenerations = 0;
+
+	// Ants per iteration of the ant colony and its iterations, 0 for DEFAULT_ACO_NUMBER_OF_ANTS and DEFAULT_ACO_ITERATIONS
+	uint32_t numberOfAnts = 0;
+	uint64_t antIterations = 0;
+
+	bool hasDeadline() const { return deadline != std::chrono::steady_clock::time_point::max(); };
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+enum SolvingAlgorithm
+{
+	GREEDY,
+	TWO_OPT,
+	RANDOM_ROUTE,
+	TWO_OPT_NEIGHBOR_LIST,
+	OR_OPT,
+	TWO_OPT_OR_OPT,
+	LIN_KERNIGHAN,
+	GREEDY_EDGE,
+	SPACE_FILLING_CURVE,
+	CHEAPEST_INSERTION,
+	NEAREST_INSERTION,
+	FARTHEST_INSERTION,
+	CONVEX_HULL_INSERTION,
+	SAVINGS,
+	DOUBLE_TREE,
+	CHRISTOFIDES,
+	SIMULATED_ANNEALING,
+	PARALLEL_TEMPERING,
+	ITERATED_LOCAL_SEARCH,
+	GENETIC_ALGORITHM,
+	ANT_COLONY,
+
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CityCoordinates.h"
+
+#include <vector>
+#include <cstdint>
+
+// Hilbert curve over the bounding square of the cities. Consecutive cities in curve order are close in space,
+// which makes the order both an O(n log n) starting tour and a cache friendly numbering of the cities.
+class SpaceFillingCurve
+{
+public:
+	// The bounding square is divided into a grid of 2^GRID_ORDER cells per side
+	static constexpr uint32_t GRID_ORDER = 16;
+
+public:
+	// Position of the grid cell (x, y) along the curve, both coordinates below 2^GRID_ORDER
+	static uint32_t getHilbertIndex(uint32_t x, uint32_t y);
+	// All cities sorted by the Hilbert index of their cell, ties by city index
+	static std::vector<uint32_t> getHilbertOrder(const CityCoordinates& coordinates);
+};
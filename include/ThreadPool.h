@@ -0,0 +1,45 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+// Fixed set of threads kept alive between rounds of work, for the metaheuristics that hand out a batch of tasks per
+// iteration and would otherwise start and join threads thousands of times. The calling thread works as worker 0.
+class ThreadPool
+{
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_roundStarted;
+	std::condition_variable m_roundFinished;
+
+	const std::function<void(uint32_t, unsigned int)>* m_task = nullptr;
+	uint32_t m_numberOfTasks = 0;
+	std::atomic<uint32_t> m_nextTask = 0;
+	uint64_t m_round = 0;
+	unsigned int m_numberOfBusyThreads = 0;
+	bool m_isStopping = false;
+
+public:
+	// 0 threads for one per hardware thread
+	explicit ThreadPool(unsigned int numberOfThreads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Workers including the calling thread, worker indices passed to tasks are below this
+	unsigned int getNumberOfWorkers() const { return m_threads.size() + 1; };
+
+	// Calls task(index, worker) for every index in [0, numberOfTasks) and returns once all calls are done. Tasks are
+	// handed out one at a time, a worker never runs two tasks at once, so per worker scratch memory needs no locking.
+	void run(uint32_t numberOfTasks, const std::function<void(uint32_t task, unsigned int worker)>& task);
+
+private:
+	void work(unsigned int worker);
+	void runTasks(unsigned int worker);
+};
@@ -1,20 +1,150 @@
 #pragma once
 
-#include "Point2D.h"
+#include "CityCoordinates.h"
+#include "CandidateLists.h"
+#include "VisualizationPolicies.h"
+#include "Route.h"
+#include "RouteLength.h"
+#include "SolvingAlgorithm.h"
+#include "SearchSettings.h"
 
 #include <vector>
 #include <atomic>
 
+// All algorithms are templates over a visualization policy (see VisualizationPolicies.h) and are explicitly 
+// instantiated for NoVisualization and AnimatedVisualization in TravelingSalesmanAlgorithms.cpp
 class TravelingSalesmanAlgorithms
 {
 public:
-	static void greedyAlgorithm(const unsigned int& timeStepMiliseconds, const std::atomic<bool>& isInterrupt, 
-		std::vector<Point2D>& points, std::vector<Point2D*>& route, float& routeLength);
+	// From this many cities on the greedy construction finds the nearest unvisited city with a kd-tree instead of a scan
+	static constexpr uint32_t GREEDY_KD_TREE_MIN_NUMBER_OF_CITIES = 2000;
 
-	static void twoOptAlgorithm(const unsigned int& timeStepMilliseconds, const std::atomic<bool>& isInterrupt,
-		std::vector<Point2D>& points, std::vector<Point2D*>& route, float& routeLength);
+	// Simulated annealing defaults: the iteration budget, the start temperature in average distances to the nearest candidate,
+	// the ratio of the end to the start temperature, and how many move evaluations pass between temperature updates and interrupt checks
+	static constexpr uint32_t DEFAULT_ANNEALING_MOVES_PER_CITY = 2000;
+	static constexpr double ANNEALING_START_TEMPERATURE_FACTOR = 0.8;
+	static constexpr double ANNEALING_END_TEMPERATURE_RATIO = 0.01;
+	static constexpr uint32_t ANNEALING_SCHEDULE_INTERVAL = 1024;
 
-	static void randomRouteAlgorithm(const unsigned int& timeStepMilliseconds, const std::atomic<bool>& isInterrupt,
-		std::vector<Point2D>& points, std::vector<Point2D*>& route, float& routeLength);
-};
+	// Iterated local search defaults: the number of kicks and the longest segment a double bridge kick moves
+	static constexpr uint32_t DEFAULT_ILS_KICKS_PER_CITY = 10;
+	static constexpr uint32_t ILS_KICK_SEGMENT_LENGTH = 50;
+
+	// Genetic algorithm defaults: the population size, the children tried per pair of parents, and one kick per this many
+	// cities when the initial population is scattered around the start route
+	static constexpr uint32_t DEFAULT_GA_POPULATION_SIZE = 30;
+	static constexpr uint32_t GA_CHILDREN_PER_PAIR = 10;
+	static constexpr uint32_t GA_INITIAL_KICK_INTERVAL = 8;
+
+	// Ant colony defaults: the ants per iteration, the iterations, the fraction of every trail evaporating per iteration,
+	// how often the best tour so far deposits instead of the best one of the iteration, and the probability of a step
+	// taking the best candidate instead of a random one
+	static constexpr uint32_t DEFAULT_ACO_NUMBER_OF_ANTS = 25;
+	static constexpr uint32_t DEFAULT_ACO_ITERATIONS = 100;
+	static constexpr double ACO_EVAPORATION = 0.2;
+	static constexpr uint32_t ACO_BEST_TOUR_INTERVAL = 5;
+	static constexpr double ACO_EXPLOITATION = 0.9;
+
+public:
+	// Runs the given algorithm; improvement algorithms (2-opt, Or-opt, Lin-Kernighan, the metaheuristics) start from the route
+	// passed in when it is complete
+	template <typename Visualization>
+	static void runAlgorithm(SolvingAlgorithm algorithm, Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength,
+		const SearchSettings& settings = SearchSettings());
+
+	// Nearest neighbor construction starting from city 0
+	template <typename Visualization>
+	static void greedyAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt, 
+		const CityCoordinates& coordinates, Route& route, RouteLength& routeLength);
+
+	// Adds the candidate edges shortest first while every city keeps at most two and no cycle closes,
+	// then joins the resulting paths nearest endpoint first
+	template <typename Visualization>
+	static void greedyEdgeAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength);
+
+	// Clarke-Wright savings: starting from one trip per city out of a central hub, merges the two trips whose joining saves the
+	// most length, considering only candidate pairs. Trips the candidate graph cannot merge are joined nearest endpoint first
+	template <typename Visualization>
+	static void savingsAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength);
+
+	// Shortcuts an Euler circuit over the minimum spanning tree of the candidate graph with all degrees made even. variant picks
+	// how: DOUBLE_TREE doubles every tree edge, CHRISTOFIDES adds a greedy matching of the odd degree cities
+	template <typename Visualization>
+	static void spanningTreeAlgorithm(SolvingAlgorithm variant, Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength);
+
+	// Visits the cities in the order of a Hilbert curve over their bounding square
+	template <typename Visualization>
+	static void spaceFillingCurveAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, Route& route, RouteLength& routeLength);
+
+	// Grows a tour by inserting one city at a time where it adds the least length. insertion picks the next city:
+	// CHEAPEST_INSERTION the one with the cheapest insertion, NEAREST_INSERTION / FARTHEST_INSERTION the one nearest to /
+	// farthest from the tour, CONVEX_HULL_INSERTION starts from the convex hull and then inserts cheapest first
+	template <typename Visualization>
+	static void insertionAlgorithm(SolvingAlgorithm insertion, Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, Route& route, RouteLength& routeLength);
 
+	template <typename Visualization>
+	static void twoOptAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, Route& route, RouteLength& routeLength);
+
+	// 2-opt restricted to moves that add an edge from a city to one of its candidate neighbors
+	template <typename Visualization>
+	static void twoOptNeighborListAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength);
+
+	// Moves segments of 1 to 3 cities, optionally reversed, next to a candidate neighbor of one of their endpoints
+	template <typename Visualization>
+	static void orOptAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength);
+
+	// Lin-Kernighan style variable-depth search: sequential k-opt moves built from a chain of 2-opt flips,
+	// each adding an edge from the current path end to one of its candidate neighbors
+	template <typename Visualization>
+	static void linKernighanAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength);
+
+	// Metropolis acceptance of random candidate 2-opt and Or-opt moves under a geometric cooling schedule, see SearchSettings.
+	// Every evaluation is O(1) and only accepted moves change the tour.
+	template <typename Visualization>
+	static void simulatedAnnealingAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength);
+
+	// Replica exchange: one annealing chain per worker thread, each at a fixed temperature of a geometric ladder between the
+	// annealing start and end temperature. After every sweep of numberOfCities moves neighboring chains swap their temperatures
+	// by the exchange criterion and the best tour so far is written to route, so it can be displayed while the search runs.
+	template <typename Visualization>
+	static void parallelTemperingAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength);
+
+	// Lin-Kernighan followed by double bridge kicks on short stretches of the tour. After each kick Lin-Kernighan runs from
+	// the kicked cities only, with all other don't-look bits set, so an iteration costs about as much as the kick is long.
+	// The result is kept when it is shorter, otherwise the journaled flips are undone. See SearchSettings for the budget.
+	template <typename Visualization>
+	static void iteratedLocalSearchAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength);
+
+	// Steady improvement of a population of tours by edge assembly crossover (EAX): a child keeps the edges of parent A
+	// except along one alternating cycle of A and B edges, where it takes those of B, and the subtours this leaves are merged.
+	// Every child gets a 2-opt repair from the cities whose edges changed. The children of all pairs are made in parallel
+	// on a thread pool, the population lives in one preallocated block, and the best tour is written to route as it improves.
+	template <typename Visualization>
+	static void geneticAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength);
+
+	// MAX-MIN ant system with the pseudo-random choice of ACS: ants walk the candidate graph guided by pheromone trails kept
+	// only on candidate edges, taking the best weighted candidate with probability ACO_EXPLOITATION, and each tour is improved
+	// by Lin-Kernighan. Only the best tour deposits pheromone, with the trails clamped between bounds derived from the best
+	// length. The ants of an iteration run in parallel on a thread pool, each with its own random numbers.
+	template <typename Visualization>
+	static void antColonyAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength);
+
+	template <typename Visualization>
+	static void randomRouteAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+		const CityCoordinates& coordinates, Route& route, RouteLength& routeLength);
+};
@@ -1,22 +1,22 @@
 #pragma once
 
-#include "Point2D.h"
+#include "CityCoordinates.h"
+#include "CandidateLists.h"
+#include "VisualizationBuffer.h"
+#include "Route.h"
+#include "RouteLength.h"
+#include "SolvingAlgorithm.h"
 
 #include <vector>
 #include <thread>
 #include <atomic>
 
-enum SolvingAlgorithm
-{
-	GREEDY,
-	TWO_OPT,
-
-};
-
 class TravelingSalesmanSolver
 {
-	std::vector<Point2D> m_points;
-	std::vector<Point2D*> m_route;
+	CityCoordinates m_coordinates;
+	CandidateLists m_candidateLists;
+	VisualizationBuffer m_visualization;
+	Route m_route;
 
 	unsigned int m_timeStepMilliseconds = 1000;
 	SolvingAlgorithm m_selectedAlgorithm = TWO_OPT;
@@ -25,7 +25,7 @@ class TravelingSalesmanSolver
 	std::atomic<bool> m_isSolving = false;
 	std::atomic<bool> m_isInterrupt = false;
 
-	float m_routeLength = 0;
+	RouteLength m_routeLength;
 
 public:
 	static int MAX_TIME_STEP_MILLISECONDS;
@@ -39,9 +39,10 @@ public:
 	bool isInterrupt() const { return m_isInterrupt; };
 	void interruptSolving() { m_isInterrupt = true; };
 
-	const std::vector<Point2D>& getPoints() const { return m_points; };
-	int getNumberOfPoints() const { return m_points.size(); };
-	const std::vector<Point2D*>& getRoute() const { return m_route; };
+	const CityCoordinates& getCoordinates() const { return m_coordinates; };
+	const VisualizationBuffer& getVisualization() const { return m_visualization; };
+	int getNumberOfPoints() const { return m_coordinates.size(); };
+	const Route& getRoute() const { return m_route; };
 	
 	unsigned int getTimeStep() const { return m_timeStepMilliseconds; };
 	void setTimeStep(int timeStepMilliseconds) 
@@ -64,7 +65,19 @@ public:
 		m_selectedAlgorithm = solvingAlgorithm; 
 	};
 
-	float getRouteLength() const { return m_routeLength; };
+	double getRouteLength() const { return m_routeLength.get(); };
+
+	DistanceMode getDistanceMode() const { return m_coordinates.getDistanceMode(); };
+	void setDistanceMode(DistanceMode distanceMode)
+	{
+		if (m_isSolving)
+		{
+			return;
+		}
+
+		m_coordinates.setDistanceMode(distanceMode);
+		m_routeLength.recompute(m_coordinates, m_route);
+	};
 
 	void generatePoints(int numberOfPoints, float xMin, float xMax, float yMin, float yMax);
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CityCoordinates.h"
+#include "Route.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum EdgeWeightType
+{
+	EUC_2D,
+	CEIL_2D,
+	ATT,
+	GEO,
+
+};
+
+struct TsplibInstance
+{
+	std::string name;
+	std::string comment;
+	EdgeWeightType edgeWeightType = EUC_2D;
+	CityCoordinates coordinates;
+
+	// The coordinates as read. The search works on their float copies in coordinates, the reported TSPLIB lengths are
+	// computed from these, so they stay comparable with published optima.
+	std::vector<double> xs;
+	std::vector<double> ys;
+	// Whether a coordinate has no exact float, so the search measures slightly moved cities (e.g. the national instances)
+	bool hasRoundedCoordinates = false;
+
+	void resize(uint32_t numberOfCities)
+	{
+		coordinates.clear();
+		coordinates.resize(numberOfCities);
+		xs.assign(numberOfCities, 0.0);
+		ys.assign(numberOfCities, 0.0);
+		hasRoundedCoordinates = false;
+	};
+	void setCity(uint32_t city, double x, double y)
+	{
+		coordinates.setCity(city, static_cast<float>(x), static_cast<float>(y));
+		xs[city] = x;
+		ys[city] = y;
+		hasRoundedCoordinates = hasRoundedCoordinates || static_cast<float>(x) != x || static_cast<float>(y) != y;
+	};
+};
+
+// Reader and writer for TSPLIB files (http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/).
+// Files are memory mapped and parsed in place, city ids in files are 1-based, in memory they are 0-based.
+class TsplibIO
+{
+public:
+	// Reads a .tsp file with a NODE_COORD_SECTION, on failure returns false and describes the problem in error
+	static bool readInstance(const std::string& path, TsplibInstance& instance, std::string& error);
+
+	// Reads a .tour file visiting every one of numberOfCities cities exactly once
+	static bool readTour(const std::string& path, uint32_t numberOfCities, Route& route, std::string& error);
+
+	static bool writeTour(const std::string& path, const std::string& name, const Route& route, int64_t routeLength);
+
+	// Distance between two cities as defined by TSPLIB for the edge weight type of the instance, from the exact coordinates
+	static int64_t getDistance(const TsplibInstance& instance, uint32_t firstCity, uint32_t secondCity);
+	static int64_t getRouteLength(const TsplibInstance& instance, const Route& route);
+
+	static bool parseEdgeWeightType(const std::string& name, EdgeWeightType& edgeWeightType);
+	static const char* getEdgeWeightTypeName(EdgeWeightType edgeWeightType);
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Route.h"
+
+#include <vector>
+#include <cstdint>
+
+// Tour kept as a cyclic sequence of segments of about sqrt(n) cities, each with a reversal bit (two-level list).
+// next, prev and between are O(1). flip splits the segments at the two ends of the path and reverses the order
+// of the whole segments in between by toggling their bits, which is O(sqrt(n)) instead of the O(n) array reversal
+// of Route. The splits leave smaller segments behind, once their count has doubled the tour is regrouped.
+// Offers the same tour queries as Route; the local searches switch to it from MIN_NUMBER_OF_CITIES cities on.
+class TwoLevelTour
+{
+	struct Segment
+	{
+		uint32_t size;
+		uint32_t rank;
+		bool isReversed;
+	};
+
+	uint32_t m_numberOfCities = 0;
+	uint32_t m_groupSize = 0;
+	uint32_t m_maxNumberOfSegments = 0;
+
+	// Segment s stores its cities in m_slots[s * m_groupSize, s * m_groupSize + size), reversed when its bit is set
+	std::vector<uint32_t> m_slots;
+	std::vector<Segment> m_segments;
+	// Segments in tour order, m_order[m_segments[s].rank] == s
+	std::vector<uint32_t> m_order;
+	std::vector<uint32_t> m_freeSegments;
+
+	std::vector<uint32_t> m_segmentOf;
+	std::vector<uint32_t> m_slotIndexOf;
+
+	std::vector<uint32_t> m_sequence;
+
+public:
+	static constexpr uint32_t MIN_NUMBER_OF_CITIES = 10000;
+
+public:
+	// Copies a complete route
+	void build(const Route& route);
+	// Replaces the cities of route with this tour
+	void writeTo(Route& route) const;
+
+	uint32_t getNumberOfCities() const { return m_numberOfCities; };
+
+	uint32_t next(uint32_t city) const
+	{
+		const uint32_t segment = m_segmentOf[city];
+		const uint32_t index = getIndexInSegment(city);
+		if (index + 1 < m_segments[segment].size)
+		{
+			return getCity(segment, index + 1);
+		}
+		const uint32_t rank = m_segments[segment].rank + 1;
+		return getCity(m_order[rank == m_order.size() ? 0 : rank], 0);
+	};
+	uint32_t prev(uint32_t city) const
+	{
+		const uint32_t segment = m_segmentOf[city];
+		const uint32_t index = getIndexInSegment(city);
+		if (index > 0)
+		{
+			return getCity(segment, index - 1);
+		}
+		const uint32_t rank = m_segments[segment].rank;
+		const uint32_t prevSegment = m_order[rank == 0 ? m_order.size() - 1 : rank - 1];
+		return getCity(prevSegment, m_segments[prevSegment].size - 1);
+	};
+	// Whether city b lies on the path walking forward from city a to city c, both ends included
+	bool between(uint32_t a, uint32_t b, uint32_t c) const
+	{
+		const uint64_t keyA = getKey(a);
+		const uint64_t keyB = getKey(b);
+		const uint64_t keyC = getKey(c);
+		if (keyA <= keyC)
+		{
+			return keyA <= keyB && keyB <= keyC;
+		}
+		return keyB >= keyA || keyB <= keyC;
+	};
+
+	// Reverses the path walking forward from city first to city last, or its complement when that has fewer segments
+	void flip(uint32_t first, uint32_t last);
+
+private:
+	uint32_t getIndexInSegment(uint32_t city) const
+	{
+		const Segment& segment = m_segments[m_segmentOf[city]];
+		return segment.isReversed ? segment.size - 1 - m_slotIndexOf[city] : m_slotIndexOf[city];
+	};
+	uint32_t getCity(uint32_t segment, uint32_t index) const
+	{
+		const Segment& data = m_segments[segment];
+		return m_slots[segment * m_groupSize + (data.isReversed ? data.size - 1 - index : index)];
+	};
+	// Position of a city in tour order starting at the first segment
+	uint64_t getKey(uint32_t city) const
+	{
+		return static_cast<uint64_t>(m_segments[m_segmentOf[city]].rank) * m_groupSize + getIndexInSegment(city);
+	};
+
+	// Regroups the cities in m_sequence into segments of m_groupSize cities
+	void regroup();
+	// Moves the cities from index on into a new segment following segment
+	void splitSegment(uint32_t segment, uint32_t index);
+	void reverseInsideSegment(uint32_t segment, uint32_t firstIndex, uint32_t lastIndex);
+	// Reverses the order of count segments starting at firstRank, wrapping around the end
+	void reverseSegments(uint32_t firstRank, uint32_t count);
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CityCoordinates.h"
+#include "CpuFeatures.h"
+#include "Route.h"
+
+#include <cstdint>
+
+// Coordinates of the cities gathered in tour order (structure of arrays, the first city repeated at the end) together
+// with the length of every tour edge, so all second edges of 2-opt moves with a fixed first edge can be evaluated from
+// contiguous memory: 8 per instruction with AVX2, 4 with SSE4.1, picked at runtime with a scalar fallback.
+class TwoOptKernel
+{
+	CityCoordinates::CoordinateArray m_xs;
+	CityCoordinates::CoordinateArray m_ys;
+	CityCoordinates::CoordinateArray m_edgeLengths;
+	uint32_t m_numberOfCities = 0;
+	DistanceMode m_distanceMode = EUCLIDEAN;
+	InstructionSet m_instructionSet = CpuFeatures::getInstructionSet();
+
+public:
+	struct Move
+	{
+		// Route length change computed in float, only a hint for picking the move
+		float delta;
+		uint32_t secondPosition;
+	};
+
+public:
+	InstructionSet getInstructionSet() const { return m_instructionSet; };
+	// Limits the kernel to the given instruction set, wider sets than the processor supports are ignored
+	void setInstructionSet(InstructionSet instructionSet);
+
+	void gather(const CityCoordinates& coordinates, const Route& route);
+	// Gathers the cities again after the cyclic range of positions [firstPosition, lastPosition] changed
+	void update(const CityCoordinates& coordinates, const Route& route, uint32_t firstPosition, uint32_t lastPosition);
+
+	// Best move replacing the edges leaving firstPosition and secondPosition, for secondPosition in [begin, end).
+	// The edges must not share a city, an empty range returns an infinite delta.
+	Move findBestMove(uint32_t firstPosition, uint32_t begin, uint32_t end) const;
+
+private:
+	void gatherPosition(const CityCoordinates& coordinates, const Route& route, uint32_t position);
+};
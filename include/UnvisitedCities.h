@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CityCoordinates.h"
+#include "CpuFeatures.h"
+
+#include <vector>
+#include <cstdint>
+
+// Cities a construction has not visited yet, kept compacted together with copies of their coordinates (SoA, aligned).
+// Removing a city moves the last one into its slot, so the nearest-city search only scans the cities that are left,
+// 8 per instruction with AVX2 or 4 with SSE4.1, picked at runtime with a scalar fallback.
+class UnvisitedCities
+{
+	std::vector<uint32_t> m_cities;
+	CityCoordinates::CoordinateArray m_xs;
+	CityCoordinates::CoordinateArray m_ys;
+	std::vector<uint32_t> m_indices;
+	InstructionSet m_instructionSet = CpuFeatures::getInstructionSet();
+
+public:
+	static constexpr uint32_t INVALID_CITY = UINT32_MAX;
+
+public:
+	// Starts with every city of coordinates unvisited
+	void reset(const CityCoordinates& coordinates);
+	void remove(uint32_t city);
+
+	uint32_t size() const { return m_cities.size(); };
+	bool isEmpty() const { return m_cities.empty(); };
+	bool contains(uint32_t city) const { return m_indices[city] != INVALID_CITY; };
+
+	InstructionSet getInstructionSet() const { return m_instructionSet; };
+	// Limits the search to the given instruction set, wider sets than the processor supports are ignored
+	void setInstructionSet(InstructionSet instructionSet);
+
+	// Unvisited city with the smallest squared distance to (x, y), INVALID_CITY when all were visited
+	uint32_t findNearest(float x, float y) const;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+
+// Per-city colors used only for rendering, kept apart from the coordinates the algorithms read
+class VisualizationBuffer
+{
+	std::vector<glm::vec3> m_pointColors;
+	std::vector<glm::vec3> m_outgoingLineColors;
+
+public:
+	void reset(uint32_t numberOfCities, glm::vec3 pointColor, glm::vec3 outgoingLineColor);
+
+	uint32_t size() const { return m_pointColors.size(); };
+
+	glm::vec3 getPointColor(uint32_t city) const { return m_pointColors[city]; };
+	void setPointColor(uint32_t city, glm::vec3 color) { m_pointColors[city] = color; };
+	glm::vec3 getOutgoingLineColor(uint32_t city) const { return m_outgoingLineColors[city]; };
+	void setOutgoingLineColor(uint32_t city, glm::vec3 color) { m_outgoingLineColors[city] = color; };
+
+	void setAllPointColors(glm::vec3 color);
+	void setAllOutgoingLineColors(glm::vec3 color);
+};
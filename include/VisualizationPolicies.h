@@ -0,0 +1,36 @@
+#pragma once
+
+#include "VisualizationBuffer.h"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+// Policies the algorithms in TravelingSalesmanAlgorithms are instantiated with. Every visual side effect of an
+// algorithm goes through one of these, so the headless instantiation compiles the animation away entirely.
+
+struct NoVisualization
+{
+	// Lets algorithms skip work that only keeps the drawn route up to date
+	static constexpr bool IS_ANIMATED = false;
+
+	void setOutgoingLineColor(uint32_t, glm::vec3) {};
+	void waitTimeStep() {};
+};
+
+class AnimatedVisualization
+{
+	VisualizationBuffer& m_buffer;
+	const unsigned int& m_timeStepMilliseconds;
+
+public:
+	static constexpr bool IS_ANIMATED = true;
+
+	AnimatedVisualization(VisualizationBuffer& buffer, const unsigned int& timeStepMilliseconds)
+		: m_buffer(buffer), m_timeStepMilliseconds(timeStepMilliseconds) {};
+
+	void setOutgoingLineColor(uint32_t city, glm::vec3 color) { m_buffer.setOutgoingLineColor(city, color); };
+	void waitTimeStep() { std::this_thread::sleep_for(std::chrono::milliseconds(m_timeStepMilliseconds)); };
+};
@@ -0,0 +1,21 @@
+#include "ActiveCityQueue.h"
+
+#include <numeric>
+
+void ActiveCityQueue::reset(uint32_t numberOfCities, bool activateAll)
+{
+    m_queue.resize(numberOfCities);
+    m_head = 0;
+
+    if (activateAll)
+    {
+        std::iota(m_queue.begin(), m_queue.end(), 0);
+        m_isQueued.assign(numberOfCities, 1);
+        m_size = numberOfCities;
+    }
+    else
+    {
+        m_isQueued.assign(numberOfCities, 0);
+        m_size = 0;
+    }
+}
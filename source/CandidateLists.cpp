@@ -0,0 +1,60 @@
+#include "CandidateLists.h"
+#include "KdTree.h"
+#include "DelaunayTriangulation.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+
+void CandidateLists::buildNearestNeighbors(const CityCoordinates& coordinates, uint32_t k, unsigned int numberOfThreads)
+{
+    const uint32_t numberOfCities = coordinates.size();
+    k = std::min(k, numberOfCities > 0 ? numberOfCities - 1 : 0);
+
+    KdTree kdTree;
+    kdTree.build(coordinates);
+
+    // Every city gets exactly k candidates, so the rows are known upfront and threads fill them independently
+    m_offsets.resize(numberOfCities + 1);
+    for (uint32_t city = 0; city <= numberOfCities; ++city)
+    {
+        m_offsets[city] = city * k;
+    }
+    m_neighbors.resize(static_cast<size_t>(numberOfCities) * k);
+
+    parallelFor(0, numberOfCities, numberOfThreads, [&](uint32_t city)
+        {
+            float squaredDistances[64];
+            std::vector<float> largeSquaredDistances;
+            float* distanceBuffer = squaredDistances;
+            if (k > 64)
+            {
+                largeSquaredDistances.resize(k);
+                distanceBuffer = largeSquaredDistances.data();
+            }
+
+            kdTree.findNearestNeighbors(city, k, m_neighbors.data() + m_offsets[city], distanceBuffer);
+        });
+}
+
+void CandidateLists::buildDelaunayNeighbors(const CityCoordinates& coordinates)
+{
+    DelaunayTriangulation triangulation;
+    triangulation.build(coordinates);
+
+    m_offsets = triangulation.getOffsets();
+    m_neighbors = triangulation.getNeighborArray();
+
+    for (uint32_t city = 0; city < coordinates.size(); ++city)
+    {
+        std::sort(m_neighbors.begin() + m_offsets[city], m_neighbors.begin() + m_offsets[city + 1], [&](uint32_t a, uint32_t b)
+            {
+                return coordinates.getSquaredDistance(city, a) < coordinates.getSquaredDistance(city, b);
+            });
+    }
+}
+
+void CandidateLists::clear()
+{
+    m_offsets.clear();
+    m_neighbors.clear();
+}
@@ -0,0 +1,25 @@
+#include "CityCoordinates.h"
+
+void CityCoordinates::clear()
+{
+    m_xs.clear();
+    m_ys.clear();
+}
+
+void CityCoordinates::reserve(uint32_t numberOfCities)
+{
+    m_xs.reserve(numberOfCities);
+    m_ys.reserve(numberOfCities);
+}
+
+void CityCoordinates::addCity(float x, float y)
+{
+    m_xs.push_back(x);
+    m_ys.push_back(y);
+}
+
+void CityCoordinates::resize(uint32_t numberOfCities)
+{
+    m_xs.resize(numberOfCities);
+    m_ys.resize(numberOfCities);
+}
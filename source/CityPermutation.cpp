@@ -0,0 +1,48 @@
+#include "CityPermutation.h"
+#include "SpaceFillingCurve.h"
+
+void CityPermutation::buildHilbertOrder(const CityCoordinates& coordinates)
+{
+    m_originalCities = SpaceFillingCurve::getHilbertOrder(coordinates);
+
+    m_permutedCities.resize(m_originalCities.size());
+    for (uint32_t permutedCity = 0; permutedCity < m_originalCities.size(); ++permutedCity)
+    {
+        m_permutedCities[m_originalCities[permutedCity]] = permutedCity;
+    }
+}
+
+void CityPermutation::clear()
+{
+    m_originalCities.clear();
+    m_permutedCities.clear();
+}
+
+void CityPermutation::permuteCoordinates(const CityCoordinates& original, CityCoordinates& permuted) const
+{
+    permuted.resize(m_originalCities.size());
+    permuted.setDistanceMode(original.getDistanceMode());
+    for (uint32_t permutedCity = 0; permutedCity < m_originalCities.size(); ++permutedCity)
+    {
+        const uint32_t originalCity = m_originalCities[permutedCity];
+        permuted.setCity(permutedCity, original.getX(originalCity), original.getY(originalCity));
+    }
+}
+
+void CityPermutation::toPermutedRoute(const Route& original, Route& permuted) const
+{
+    permuted.reset(original.getNumberOfCities());
+    for (uint32_t city : original.getCities())
+    {
+        permuted.append(m_permutedCities[city]);
+    }
+}
+
+void CityPermutation::toOriginalRoute(const Route& permuted, Route& original) const
+{
+    original.reset(permuted.getNumberOfCities());
+    for (uint32_t city : permuted.getCities())
+    {
+        original.append(m_originalCities[city]);
+    }
+}
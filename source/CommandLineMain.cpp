@@ -0,0 +1,693 @@
+#include "TravelingSalesmanAlgorithms.h"
+#include "CityCoordinates.h"
+#include "CandidateLists.h"
+#include "Route.h"
+#include "RouteLength.h"
+#include "TsplibIO.h"
+#include "CpuFeatures.h"
+#include "CityPermutation.h"
+#include "FastRandom.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+// Headless batch solver: reads an instance, runs an algorithm pipeline with the visualization compiled out
+// and writes the best tour found together with solving statistics.
+
+struct CommandLineOptions
+{
+	std::string inputPath;
+	std::string outputPath;
+	std::string initialTourPath;
+	std::vector<SolvingAlgorithm> pipeline = { GREEDY, TWO_OPT };
+	double timeLimitSeconds = 0.0;
+	std::string distanceMode = "auto";
+	uint32_t numberOfNeighbors = CandidateLists::DEFAULT_NUMBER_OF_NEIGHBORS;
+	bool isUsingDelaunayCandidates = false;
+	// Thread 0 runs with seed, the others with seeds derived from it
+	SearchSettings searchSettings;
+	unsigned int numberOfThreads = 1;
+	bool isReorderingCities = true;
+	bool isShowingHelp = false;
+};
+
+struct SolveResult
+{
+	Route route;
+	RouteLength routeLength;
+	std::vector<double> stageSeconds;
+};
+
+static void printUsage(std::ostream& stream, const char* executableName);
+static bool parseAlgorithmName(const std::string& name, SolvingAlgorithm& algorithm);
+static const char* getAlgorithmName(SolvingAlgorithm algorithm);
+static bool parseArguments(int argc, char** argv, CommandLineOptions& options);
+static bool hasExtension(const std::string& path, const std::string& extension);
+static bool readInstance(const std::string& path, TsplibInstance& instance, std::string& error);
+static bool writeRoute(const std::string& path, const TsplibInstance& instance, const Route& route);
+static bool applyDistanceMode(const std::string& name, TsplibInstance& instance);
+static void completeRoute(Route& route);
+
+int main(int argc, char** argv)
+{
+	CommandLineOptions options;
+	if (!parseArguments(argc, argv, options))
+	{
+		printUsage(std::cerr, argv[0]);
+		return 1;
+	}
+	if (options.isShowingHelp)
+	{
+		printUsage(std::cout, argv[0]);
+		return 0;
+	}
+
+	TsplibInstance instance;
+	std::string error;
+
+	const auto readStart = std::chrono::steady_clock::now();
+	if (!readInstance(options.inputPath, instance, error))
+	{
+		std::cerr << "Failed to read instance " << options.inputPath << ": " << error << "\n";
+		return 1;
+	}
+	const double readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - readStart).count();
+
+	if (!applyDistanceMode(options.distanceMode, instance))
+	{
+		std::cerr << "Unknown distance mode " << options.distanceMode << "\n";
+		return 1;
+	}
+	// Only the integer modes promise exact lengths, Euclidean distances are rounded to float anyway
+	if (instance.hasRoundedCoordinates && instance.coordinates.isIntegerDistanceMode())
+	{
+		std::cerr << "Warning: some coordinates have no exact float, the search measures the cities rounded to float"
+			<< " and only the reported TSPLIB length uses the exact coordinates\n";
+	}
+	if (instance.edgeWeightType == GEO)
+	{
+		std::cerr << "Warning: there is no GEO distance mode, the search measures the raw latitudes and longitudes in the plane"
+			<< " and only the reported length uses GEO distances\n";
+	}
+
+	if (instance.coordinates.isEmpty())
+	{
+		std::cerr << "Instance " << options.inputPath << " contains no cities\n";
+		return 1;
+	}
+
+	// The algorithms run on the renumbered cities, routes are translated back before anything is reported
+	CityPermutation permutation;
+	CityCoordinates permutedCoordinates;
+	if (options.isReorderingCities)
+	{
+		permutation.buildHilbertOrder(instance.coordinates);
+		permutation.permuteCoordinates(instance.coordinates, permutedCoordinates);
+	}
+	const CityCoordinates& coordinates = options.isReorderingCities ? permutedCoordinates : instance.coordinates;
+
+	Route initialRoute;
+	if (!options.initialTourPath.empty() && !TsplibIO::readTour(options.initialTourPath, coordinates.size(), initialRoute, error))
+	{
+		std::cerr << "Failed to read tour " << options.initialTourPath << ": " << error << "\n";
+		return 1;
+	}
+	if (options.isReorderingCities && initialRoute.isComplete())
+	{
+		Route originalInitialRoute = initialRoute;
+		permutation.toPermutedRoute(originalInitialRoute, initialRoute);
+	}
+
+	const auto candidateListsStart = std::chrono::steady_clock::now();
+	CandidateLists candidateLists;
+	if (options.isUsingDelaunayCandidates)
+	{
+		candidateLists.buildDelaunayNeighbors(coordinates);
+	}
+	else
+	{
+		candidateLists.buildNearestNeighbors(coordinates, options.numberOfNeighbors, std::thread::hardware_concurrency());
+	}
+	const double candidateListsSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - candidateListsStart).count();
+
+	std::atomic<bool> isInterrupt = false;
+
+	// Watchdog raising the interrupt flag once the time budget runs out
+	std::mutex watchdogMutex;
+	std::condition_variable watchdogCondition;
+	bool isFinished = false;
+	std::thread watchdog;
+	if (options.timeLimitSeconds > 0.0)
+	{
+		watchdog = std::thread([&]()
+			{
+				std::unique_lock<std::mutex> lock(watchdogMutex);
+				if (!watchdogCondition.wait_for(lock, std::chrono::duration<double>(options.timeLimitSeconds), [&]() { return isFinished; }))
+				{
+					isInterrupt = true;
+				}
+			});
+	}
+
+	const auto solveStart = std::chrono::steady_clock::now();
+	if (options.timeLimitSeconds > 0.0)
+	{
+		options.searchSettings.deadline = solveStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(options.timeLimitSeconds));
+	}
+
+	// Every thread runs the whole pipeline independently, randomized stages make the runs differ
+	std::vector<SolveResult> results(options.numberOfThreads);
+	std::vector<std::thread> workers;
+	for (unsigned int threadIndex = 0; threadIndex < options.numberOfThreads; ++threadIndex)
+	{
+		workers.emplace_back([&, threadIndex]()
+			{
+				SolveResult& result = results[threadIndex];
+				NoVisualization visualization;
+				RouteLength& routeLength = result.routeLength;
+				SearchSettings settings = options.searchSettings;
+				settings.seed = threadIndex == 0 ? settings.seed : FastRandom::deriveSeed(settings.seed, threadIndex);
+
+				result.route.reset(coordinates.size());
+				routeLength.reset(coordinates);
+				if (initialRoute.isComplete())
+				{
+					result.route = initialRoute;
+					routeLength.recompute(coordinates, initialRoute);
+				}
+
+				for (SolvingAlgorithm algorithm : options.pipeline)
+				{
+					const auto stageStart = std::chrono::steady_clock::now();
+					TravelingSalesmanAlgorithms::runAlgorithm(algorithm, visualization, isInterrupt, coordinates, candidateLists, result.route, routeLength, settings);
+					result.stageSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - stageStart).count());
+				}
+
+				completeRoute(result.route);
+				routeLength.recompute(coordinates, result.route);
+			});
+	}
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	const double solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+
+	if (watchdog.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(watchdogMutex);
+			isFinished = true;
+		}
+		watchdogCondition.notify_one();
+		watchdog.join();
+	}
+
+	const SolveResult& best = *std::min_element(results.begin(), results.end(),
+		[](const SolveResult& a, const SolveResult& b) { return a.routeLength.get() < b.routeLength.get(); });
+
+	Route bestRoute = best.route;
+	if (options.isReorderingCities)
+	{
+		permutation.toOriginalRoute(best.route, bestRoute);
+	}
+
+	std::cout << "Instance: " << instance.name << " (" << TsplibIO::getEdgeWeightTypeName(instance.edgeWeightType) << ")\n";
+	std::cout << "Cities: " << coordinates.size() << "\n";
+	std::cout << "Read time: " << readSeconds << " s\n";
+	std::cout << "Candidate lists time: " << candidateListsSeconds << " s\n";
+	std::cout << "Threads: " << options.numberOfThreads << "\n";
+	std::cout << "SIMD: " << CpuFeatures::getInstructionSetName(CpuFeatures::getInstructionSet()) << "\n";
+	for (size_t i = 0; i < options.pipeline.size(); ++i)
+	{
+		std::cout << "Stage " << getAlgorithmName(options.pipeline[i]) << ": " << best.stageSeconds[i] << " s\n";
+	}
+	std::cout << "Interrupted: " << (isInterrupt ? "yes" : "no") << "\n";
+	std::cout << "Solve time: " << solveSeconds << " s\n";
+	std::cout << "Distance mode: " << options.distanceMode << "\n";
+	std::cout.precision(12);
+	if (best.routeLength.isInteger())
+	{
+		std::cout << "Route length: " << best.routeLength.getInteger() << "\n";
+	}
+	else
+	{
+		std::cout << "Route length: " << best.routeLength.get() << "\n";
+	}
+	std::cout << "TSPLIB route length: " << TsplibIO::getRouteLength(instance, bestRoute) << "\n";
+
+	if (!options.outputPath.empty() && !writeRoute(options.outputPath, instance, bestRoute))
+	{
+		std::cerr << "Failed to write route to " << options.outputPath << "\n";
+		return 1;
+	}
+
+	return 0;
+}
+
+static void printUsage(std::ostream& stream, const char* executableName)
+{
+	stream << "Usage: " << executableName << " --input <file> [options]\n"
+		<< "  --input <file>          TSPLIB .tsp instance, or any other file with one \"x y\" coordinate pair per line\n"
+		<< "  --output <file>         file the route is written to, TSPLIB format for .tour files, else one city index per line\n"
+		<< "  --initial-tour <file>   TSPLIB .tour file the pipeline starts from\n"
+		<< "  --algorithms <a,b,...>  pipeline of algorithms run in order (greedy, random, two-opt, two-opt-nl, or-opt, lk, greedy-edge, hilbert,\n"
+		<< "                          cheapest-insertion, nearest-insertion, farthest-insertion, hull-insertion, savings, double-tree,\n"
+		<< "                          christofides, annealing, tempering, ils, genetic, ants), default greedy,two-opt\n"
+		<< "  --time-limit <seconds>  time budget after which solving is interrupted, default unlimited\n"
+		<< "  --threads <count>       number of independent pipeline runs in parallel, default 1\n"
+		<< "  --distance-mode <mode>  euclidean, nint, ceil or att; default auto picks nint for EUC_2D, ceil for CEIL_2D, att for ATT,\n"
+		<< "                          else euclidean\n"
+		<< "  --neighbors <count>     number of nearest neighbor candidates per city, default " << CandidateLists::DEFAULT_NUMBER_OF_NEIGHBORS << "\n"
+		<< "  --candidates <type>     candidate neighbors of each city: knn (the --neighbors nearest) or delaunay, default knn\n"
+		<< "  --worker-threads <count>  threads of the parallel metaheuristics within each run, default one per hardware thread\n"
+		<< "  --seed <number>         seed of the randomized metaheuristics in the first thread, the others derive theirs from it, default 1\n"
+		<< "  --sa-iterations <count> move evaluations of simulated annealing, default " << TravelingSalesmanAlgorithms::DEFAULT_ANNEALING_MOVES_PER_CITY << " per city\n"
+		<< "  --sa-temperatures <start,end>  geometric cooling schedule of simulated annealing, default derived from the start tour\n"
+		<< "  --ils-kicks <count>     double bridge kicks of iterated local search, default " << TravelingSalesmanAlgorithms::DEFAULT_ILS_KICKS_PER_CITY << " per city\n"
+		<< "  --ga-population <count> individuals of the genetic algorithm, default " << TravelingSalesmanAlgorithms::DEFAULT_GA_POPULATION_SIZE << "\n"
+		<< "  --ga-generations <count>  generations of the genetic algorithm, default until a generation improves no individual\n"
+		<< "  --aco-ants <count>      ants per iteration of the ant colony, default " << TravelingSalesmanAlgorithms::DEFAULT_ACO_NUMBER_OF_ANTS << "\n"
+		<< "  --aco-iterations <count>  iterations of the ant colony, default " << TravelingSalesmanAlgorithms::DEFAULT_ACO_ITERATIONS << "\n"
+		<< "  --reorder-cities <on|off>  solve on the cities renumbered in Hilbert curve order for memory locality, default on\n"
+		<< "  -h, --help              print this help and exit\n";
+}
+
+static bool parseAlgorithmName(const std::string& name, SolvingAlgorithm& algorithm)
+{
+	if (name == "greedy")
+	{
+		algorithm = GREEDY;
+	}
+	else if (name == "two-opt")
+	{
+		algorithm = TWO_OPT;
+	}
+	else if (name == "random")
+	{
+		algorithm = RANDOM_ROUTE;
+	}
+	else if (name == "two-opt-nl")
+	{
+		algorithm = TWO_OPT_NEIGHBOR_LIST;
+	}
+	else if (name == "or-opt")
+	{
+		algorithm = OR_OPT;
+	}
+	else if (name == "lk")
+	{
+		algorithm = LIN_KERNIGHAN;
+	}
+	else if (name == "greedy-edge")
+	{
+		algorithm = GREEDY_EDGE;
+	}
+	else if (name == "hilbert")
+	{
+		algorithm = SPACE_FILLING_CURVE;
+	}
+	else if (name == "cheapest-insertion")
+	{
+		algorithm = CHEAPEST_INSERTION;
+	}
+	else if (name == "nearest-insertion")
+	{
+		algorithm = NEAREST_INSERTION;
+	}
+	else if (name == "farthest-insertion")
+	{
+		algorithm = FARTHEST_INSERTION;
+	}
+	else if (name == "hull-insertion")
+	{
+		algorithm = CONVEX_HULL_INSERTION;
+	}
+	else if (name == "savings")
+	{
+		algorithm = SAVINGS;
+	}
+	else if (name == "double-tree")
+	{
+		algorithm = DOUBLE_TREE;
+	}
+	else if (name == "christofides")
+	{
+		algorithm = CHRISTOFIDES;
+	}
+	else if (name == "annealing")
+	{
+		algorithm = SIMULATED_ANNEALING;
+	}
+	else if (name == "tempering")
+	{
+		algorithm = PARALLEL_TEMPERING;
+	}
+	else if (name == "ils")
+	{
+		algorithm = ITERATED_LOCAL_SEARCH;
+	}
+	else if (name == "genetic")
+	{
+		algorithm = GENETIC_ALGORITHM;
+	}
+	else if (name == "ants")
+	{
+		algorithm = ANT_COLONY;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+static const char* getAlgorithmName(SolvingAlgorithm algorithm)
+{
+	switch (algorithm)
+	{
+	case GREEDY:
+		return "greedy";
+	case TWO_OPT:
+		return "two-opt";
+	case RANDOM_ROUTE:
+		return "random";
+	case TWO_OPT_NEIGHBOR_LIST:
+		return "two-opt-nl";
+	case OR_OPT:
+		return "or-opt";
+	case TWO_OPT_OR_OPT:
+		return "two-opt,or-opt";
+	case LIN_KERNIGHAN:
+		return "lk";
+	case GREEDY_EDGE:
+		return "greedy-edge";
+	case SPACE_FILLING_CURVE:
+		return "hilbert";
+	case CHEAPEST_INSERTION:
+		return "cheapest-insertion";
+	case NEAREST_INSERTION:
+		return "nearest-insertion";
+	case FARTHEST_INSERTION:
+		return "farthest-insertion";
+	case CONVEX_HULL_INSERTION:
+		return "hull-insertion";
+	case SAVINGS:
+		return "savings";
+	case DOUBLE_TREE:
+		return "double-tree";
+	case CHRISTOFIDES:
+		return "christofides";
+	case SIMULATED_ANNEALING:
+		return "annealing";
+	case PARALLEL_TEMPERING:
+		return "tempering";
+	case ITERATED_LOCAL_SEARCH:
+		return "ils";
+	case GENETIC_ALGORITHM:
+		return "genetic";
+	case ANT_COLONY:
+		return "ants";
+	}
+	return "unknown";
+}
+
+static bool parseArguments(int argc, char** argv, CommandLineOptions& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string argument = argv[i];
+		// The only option without a value
+		if (argument == "--help" || argument == "-h")
+		{
+			options.isShowingHelp = true;
+			return true;
+		}
+		if (i + 1 >= argc)
+		{
+			std::cerr << "Missing value for " << argument << "\n";
+			return false;
+		}
+		const std::string value = argv[++i];
+
+		try
+		{
+			if (argument == "--input")
+			{
+				options.inputPath = value;
+			}
+			else if (argument == "--output")
+			{
+				options.outputPath = value;
+			}
+			else if (argument == "--initial-tour")
+			{
+				options.initialTourPath = value;
+			}
+			else if (argument == "--algorithms")
+			{
+				options.pipeline.clear();
+
+				std::stringstream names(value);
+				std::string name;
+				while (std::getline(names, name, ','))
+				{
+					SolvingAlgorithm algorithm;
+					if (!parseAlgorithmName(name, algorithm))
+					{
+						std::cerr << "Unknown algorithm " << name << "\n";
+						return false;
+					}
+					options.pipeline.push_back(algorithm);
+				}
+			}
+			else if (argument == "--time-limit")
+			{
+				options.timeLimitSeconds = std::stod(value);
+			}
+			else if (argument == "--threads")
+			{
+				options.numberOfThreads = std::max(1, std::stoi(value));
+			}
+			else if (argument == "--distance-mode")
+			{
+				options.distanceMode = value;
+			}
+			else if (argument == "--neighbors")
+			{
+				options.numberOfNeighbors = std::max(1, std::stoi(value));
+			}
+			else if (argument == "--worker-threads")
+			{
+				options.searchSettings.numberOfWorkerThreads = std::max(1, std::stoi(value));
+			}
+			else if (argument == "--seed")
+			{
+				options.searchSettings.seed = std::stoull(value);
+			}
+			else if (argument == "--sa-iterations")
+			{
+				options.searchSettings.annealingIterations = std::stoull(value);
+			}
+			else if (argument == "--ils-kicks")
+			{
+				options.searchSettings.localSearchKicks = std::stoull(value);
+			}
+			else if (argument == "--ga-population")
+			{
+				options.searchSettings.populationSize = std::max(2, std::stoi(value));
+			}
+			else if (argument == "--ga-generations")
+			{
+				options.searchSettings.geneticGenerations = std::stoull(value);
+			}
+			else if (argument == "--aco-ants")
+			{
+				options.searchSettings.numberOfAnts = std::max(1, std::stoi(value));
+			}
+			else if (argument == "--aco-iterations")
+			{
+				options.searchSettings.antIterations = std::stoull(value);
+			}
+			else if (argument == "--sa-temperatures")
+			{
+				const size_t separator = value.find(',');
+				if (separator == std::string::npos)
+				{
+					std::cerr << "Expected <start,end> for " << argument << "\n";
+					return false;
+				}
+				options.searchSettings.annealingStartTemperature = std::stod(value.substr(0, separator));
+				options.searchSettings.annealingEndTemperature = std::stod(value.substr(separator + 1));
+				if (options.searchSettings.annealingStartTemperature <= 0.0 || options.searchSettings.annealingEndTemperature <= 0.0)
+				{
+					std::cerr << "Temperatures have to be positive\n";
+					return false;
+				}
+			}
+			else if (argument == "--candidates")
+			{
+				if (value != "knn" && value != "delaunay")
+				{
+					std::cerr << "Expected knn or delaunay for " << argument << "\n";
+					return false;
+				}
+				options.isUsingDelaunayCandidates = value == "delaunay";
+			}
+			else if (argument == "--reorder-cities")
+			{
+				if (value != "on" && value != "off")
+				{
+					std::cerr << "Expected on or off for " << argument << "\n";
+					return false;
+				}
+				options.isReorderingCities = value == "on";
+			}
+			else
+			{
+				std::cerr << "Unknown option " << argument << "\n";
+				return false;
+			}
+		}
+		catch (const std::exception&)
+		{
+			std::cerr << "Invalid value " << value << " for " << argument << "\n";
+			return false;
+		}
+	}
+
+	return !options.inputPath.empty() && !options.pipeline.empty();
+}
+
+static bool hasExtension(const std::string& path, const std::string& extension)
+{
+	return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+static bool readInstance(const std::string& path, TsplibInstance& instance, std::string& error)
+{
+	if (hasExtension(path, ".tsp"))
+	{
+		return TsplibIO::readInstance(path, instance, error);
+	}
+
+	std::ifstream file(path);
+	if (!file)
+	{
+		error = "cannot open " + path;
+		return false;
+	}
+
+	instance.name = path.substr(path.find_last_of("/\\") + 1);
+	instance.edgeWeightType = EUC_2D;
+
+	std::vector<double> xs, ys;
+	double x, y;
+	while (file >> x >> y)
+	{
+		xs.push_back(x);
+		ys.push_back(y);
+	}
+
+	if (!file.eof())
+	{
+		error = "malformed coordinate pair after city " + std::to_string(xs.size());
+		return false;
+	}
+
+	instance.resize(xs.size());
+	for (uint32_t city = 0; city < xs.size(); ++city)
+	{
+		instance.setCity(city, xs[city], ys[city]);
+	}
+	return true;
+}
+
+static bool writeRoute(const std::string& path, const TsplibInstance& instance, const Route& route)
+{
+	if (hasExtension(path, ".tour"))
+	{
+		return TsplibIO::writeTour(path, instance.name, route, TsplibIO::getRouteLength(instance, route));
+	}
+
+	std::ofstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+
+	for (uint32_t city : route.getCities())
+	{
+		file << city << "\n";
+	}
+
+	return static_cast<bool>(file);
+}
+
+static bool applyDistanceMode(const std::string& name, TsplibInstance& instance)
+{
+	DistanceMode distanceMode;
+	if (name == "auto")
+	{
+		switch (instance.edgeWeightType)
+		{
+		case EUC_2D:
+			distanceMode = ROUNDED_EUCLIDEAN;
+			break;
+		case CEIL_2D:
+			distanceMode = CEILED_EUCLIDEAN;
+			break;
+		case ATT:
+			distanceMode = PSEUDO_EUCLIDEAN;
+			break;
+		default:
+			distanceMode = EUCLIDEAN;
+			break;
+		}
+	}
+	else if (name == "euclidean")
+	{
+		distanceMode = EUCLIDEAN;
+	}
+	else if (name == "nint")
+	{
+		distanceMode = ROUNDED_EUCLIDEAN;
+	}
+	else if (name == "ceil")
+	{
+		distanceMode = CEILED_EUCLIDEAN;
+	}
+	else if (name == "att")
+	{
+		distanceMode = PSEUDO_EUCLIDEAN;
+	}
+	else
+	{
+		return false;
+	}
+
+	instance.coordinates.setDistanceMode(distanceMode);
+	return true;
+}
+
+// A construction interrupted by the time limit leaves a partial route, the missing cities are appended in index order
+static void completeRoute(Route& route)
+{
+	for (uint32_t city = 0; city < route.getNumberOfCities() && !route.isComplete(); ++city)
+	{
+		if (!route.contains(city))
+		{
+			route.append(city);
+		}
+	}
+}
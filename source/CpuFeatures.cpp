@@ -0,0 +1,65 @@
+#include "CpuFeatures.h"
+
+#if defined(SIMD_KERNELS_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+static InstructionSet detectInstructionSet()
+{
+#if defined(SIMD_KERNELS_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool hasSse41 = (info[2] & (1 << 19)) != 0;
+    const bool hasOsXsave = (info[2] & (1 << 27)) != 0;
+    const bool hasAvx = (info[2] & (1 << 28)) != 0;
+    // The operating system has to save the YMM registers on context switches
+    const bool hasYmmState = hasOsXsave && (_xgetbv(0) & 0x6) == 0x6;
+
+    bool hasAvx2 = false;
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        hasAvx2 = (info[1] & (1 << 5)) != 0;
+    }
+
+    if (hasAvx && hasYmmState && hasAvx2)
+    {
+        return AVX2;
+    }
+    return hasSse41 ? SSE41 : SCALAR;
+#elif defined(SIMD_KERNELS_X86)
+    // Also checks that the operating system enabled the AVX state
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return AVX2;
+    }
+    return __builtin_cpu_supports("sse4.1") ? SSE41 : SCALAR;
+#else
+    return SCALAR;
+#endif
+}
+
+InstructionSet CpuFeatures::getInstructionSet()
+{
+    static const InstructionSet instructionSet = detectInstructionSet();
+    return instructionSet;
+}
+
+const char* CpuFeatures::getInstructionSetName(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case SCALAR:
+        return "scalar";
+    case SSE41:
+        return "SSE4.1";
+    case AVX2:
+        return "AVX2";
+    }
+    return "unknown";
+}
@@ -0,0 +1,451 @@
+#include "DelaunayTriangulation.h"
+#include "GeometricPredicates.h"
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace
+{
+    double getSquaredDistance(double ax, double ay, double bx, double by)
+    {
+        return (ax - bx) * (ax - bx) + (ay - by) * (ay - by);
+    }
+
+    // Squared radius of the circle through a, b, c, infinite when they are collinear
+    double getSquaredCircumradius(double ax, double ay, double bx, double by, double cx, double cy)
+    {
+        const double dx = bx - ax;
+        const double dy = by - ay;
+        const double ex = cx - ax;
+        const double ey = cy - ay;
+        const double bl = dx * dx + dy * dy;
+        const double cl = ex * ex + ey * ey;
+        const double d = 0.5 / (dx * ey - dy * ex);
+        const double x = (ey * bl - dy * cl) * d;
+        const double y = (dx * cl - ex * bl) * d;
+        const double squaredRadius = x * x + y * y;
+        return std::isfinite(squaredRadius) ? squaredRadius : std::numeric_limits<double>::infinity();
+    }
+
+    void getCircumcenter(double ax, double ay, double bx, double by, double cx, double cy, double& x, double& y)
+    {
+        const double dx = bx - ax;
+        const double dy = by - ay;
+        const double ex = cx - ax;
+        const double ey = cy - ay;
+        const double bl = dx * dx + dy * dy;
+        const double cl = ex * ex + ey * ey;
+        const double d = 0.5 / (dx * ey - dy * ex);
+        x = ax + (ey * bl - dy * cl) * d;
+        y = ay + (dx * cl - ex * bl) * d;
+    }
+
+    // Monotone in the angle of (dx, dy) and cheaper than atan2, in [0, 1]
+    double getPseudoAngle(double dx, double dy)
+    {
+        const double sum = std::abs(dx) + std::abs(dy);
+        if (sum == 0.0)
+        {
+            return 0.0;
+        }
+        const double p = dx / sum;
+        return (dy > 0.0 ? 3.0 - p : 1.0 + p) / 4.0;
+    }
+
+    uint32_t getNextHalfedge(uint32_t halfedge)
+    {
+        return halfedge % 3 == 2 ? halfedge - 2 : halfedge + 1;
+    }
+}
+
+void DelaunayTriangulation::build(const CityCoordinates& coordinates)
+{
+    m_coordinates = &coordinates;
+    const uint32_t numberOfCities = coordinates.size();
+
+    m_triangles.clear();
+    m_halfedges.clear();
+
+    // Pairs of cities connected besides the triangulation: copies to their position, collinear cities to their successor
+    std::vector<uint32_t> extraEdges;
+
+    // Seed triangle: the city closest to the center of the bounding box, its nearest city and the city making the smallest circle with both
+    uint32_t seeds[3] = { 0, 0, 0 };
+    double minSquaredRadius = std::numeric_limits<double>::infinity();
+    if (numberOfCities >= 3)
+    {
+        const auto [minX, maxX] = std::minmax_element(coordinates.getXs(), coordinates.getXs() + numberOfCities);
+        const auto [minY, maxY] = std::minmax_element(coordinates.getYs(), coordinates.getYs() + numberOfCities);
+        const double boxCenterX = (static_cast<double>(*minX) + *maxX) / 2.0;
+        const double boxCenterY = (static_cast<double>(*minY) + *maxY) / 2.0;
+
+        auto findClosest = [&](double x, double y, uint32_t excluded)
+        {
+            uint32_t closest = 0;
+            double closestSquaredDistance = std::numeric_limits<double>::infinity();
+            for (uint32_t city = 0; city < numberOfCities; ++city)
+            {
+                const double squaredDistance = getSquaredDistance(x, y, coordinates.getX(city), coordinates.getY(city));
+                if (city != excluded && squaredDistance > 0.0 && squaredDistance < closestSquaredDistance)
+                {
+                    closest = city;
+                    closestSquaredDistance = squaredDistance;
+                }
+            }
+            return closest;
+        };
+
+        seeds[0] = 0;
+        double seedSquaredDistance = std::numeric_limits<double>::infinity();
+        for (uint32_t city = 0; city < numberOfCities; ++city)
+        {
+            const double squaredDistance = getSquaredDistance(boxCenterX, boxCenterY, coordinates.getX(city), coordinates.getY(city));
+            if (squaredDistance < seedSquaredDistance)
+            {
+                seeds[0] = city;
+                seedSquaredDistance = squaredDistance;
+            }
+        }
+        seeds[1] = findClosest(coordinates.getX(seeds[0]), coordinates.getY(seeds[0]), seeds[0]);
+
+        for (uint32_t city = 0; city < numberOfCities; ++city)
+        {
+            if (city == seeds[0] || city == seeds[1])
+            {
+                continue;
+            }
+            const double squaredRadius = getSquaredCircumradius(coordinates.getX(seeds[0]), coordinates.getY(seeds[0]),
+                coordinates.getX(seeds[1]), coordinates.getY(seeds[1]), coordinates.getX(city), coordinates.getY(city));
+            if (squaredRadius < minSquaredRadius)
+            {
+                seeds[2] = city;
+                minSquaredRadius = squaredRadius;
+            }
+        }
+    }
+
+    // Without three cities off a line there are no triangles, the cities are connected in order along the line
+    if (minSquaredRadius == std::numeric_limits<double>::infinity()
+        || GeometricPredicates::orientation(coordinates.getX(seeds[0]), coordinates.getY(seeds[0]), coordinates.getX(seeds[1]),
+            coordinates.getY(seeds[1]), coordinates.getX(seeds[2]), coordinates.getY(seeds[2])) == 0)
+    {
+        std::vector<uint32_t> order(numberOfCities);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+            {
+                return coordinates.getX(a) != coordinates.getX(b) ? coordinates.getX(a) < coordinates.getX(b) : coordinates.getY(a) < coordinates.getY(b);
+            });
+        for (uint32_t i = 1; i < numberOfCities; ++i)
+        {
+            extraEdges.push_back(order[i - 1]);
+            extraEdges.push_back(order[i]);
+        }
+        buildAdjacency(extraEdges);
+        return;
+    }
+
+    if (GeometricPredicates::orientation(coordinates.getX(seeds[0]), coordinates.getY(seeds[0]), coordinates.getX(seeds[1]),
+        coordinates.getY(seeds[1]), coordinates.getX(seeds[2]), coordinates.getY(seeds[2])) < 0)
+    {
+        std::swap(seeds[1], seeds[2]);
+    }
+    getCircumcenter(coordinates.getX(seeds[0]), coordinates.getY(seeds[0]), coordinates.getX(seeds[1]), coordinates.getY(seeds[1]),
+        coordinates.getX(seeds[2]), coordinates.getY(seeds[2]), m_centerX, m_centerY);
+
+    std::vector<double> squaredDistances(numberOfCities);
+    for (uint32_t city = 0; city < numberOfCities; ++city)
+    {
+        squaredDistances[city] = getSquaredDistance(m_centerX, m_centerY, coordinates.getX(city), coordinates.getY(city));
+    }
+    std::vector<uint32_t> order(numberOfCities);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            if (squaredDistances[a] != squaredDistances[b])
+            {
+                return squaredDistances[a] < squaredDistances[b];
+            }
+            if (coordinates.getX(a) != coordinates.getX(b))
+            {
+                return coordinates.getX(a) < coordinates.getX(b);
+            }
+            return coordinates.getY(a) != coordinates.getY(b) ? coordinates.getY(a) < coordinates.getY(b) : a < b;
+        });
+
+    const uint32_t hashSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(numberOfCities))));
+    m_hullPrevious.assign(numberOfCities, 0);
+    m_hullNext.assign(numberOfCities, 0);
+    m_hullHalfedges.assign(numberOfCities, 0);
+    m_hullHash.assign(hashSize, INVALID_HALFEDGE);
+
+    // A triangulation of n cities has at most 2n - 5 triangles
+    m_triangles.reserve(3 * static_cast<size_t>(std::max<uint32_t>(2 * numberOfCities, 5) - 5));
+    m_halfedges.reserve(m_triangles.capacity());
+
+    m_hullStart = seeds[0];
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        m_hullNext[seeds[i]] = seeds[(i + 1) % 3];
+        m_hullPrevious[seeds[(i + 1) % 3]] = seeds[i];
+        m_hullHalfedges[seeds[i]] = i;
+        m_hullHash[getHullHashKey(coordinates.getX(seeds[i]), coordinates.getY(seeds[i]))] = seeds[i];
+    }
+    addTriangle(seeds[0], seeds[1], seeds[2], INVALID_HALFEDGE, INVALID_HALFEDGE, INVALID_HALFEDGE);
+
+    for (uint32_t k = 0; k < numberOfCities; ++k)
+    {
+        const uint32_t city = order[k];
+        const float x = coordinates.getX(city);
+        const float y = coordinates.getY(city);
+
+        // Cities at the same position follow each other
+        if (k > 0 && x == coordinates.getX(order[k - 1]) && y == coordinates.getY(order[k - 1]))
+        {
+            extraEdges.push_back(order[k - 1]);
+            extraEdges.push_back(city);
+            continue;
+        }
+        if (city == seeds[0] || city == seeds[1] || city == seeds[2])
+        {
+            continue;
+        }
+
+        // Start at a hull city of similar angle and walk forward to the first hull edge the city sees
+        uint32_t start = INVALID_HALFEDGE;
+        const uint32_t key = getHullHashKey(x, y);
+        for (uint32_t j = 0; j < hashSize; ++j)
+        {
+            start = m_hullHash[(key + j) % hashSize];
+            if (start != INVALID_HALFEDGE && start != m_hullNext[start])
+            {
+                break;
+            }
+        }
+
+        start = m_hullPrevious[start];
+        uint32_t edgeStart = start;
+        while (!isVisible(edgeStart, m_hullNext[edgeStart], x, y))
+        {
+            edgeStart = m_hullNext[edgeStart];
+            if (edgeStart == start)
+            {
+                edgeStart = INVALID_HALFEDGE;
+                break;
+            }
+        }
+
+        // Only possible for a copy of a seed ordered before it, the seed gets connected to it in turn
+        if (edgeStart == INVALID_HALFEDGE)
+        {
+            extraEdges.push_back(order[k - 1]);
+            extraEdges.push_back(city);
+            continue;
+        }
+
+        uint32_t triangle = addTriangle(edgeStart, city, m_hullNext[edgeStart], INVALID_HALFEDGE, INVALID_HALFEDGE, m_hullHalfedges[edgeStart]);
+        m_hullHalfedges[city] = legalize(triangle + 2);
+        m_hullHalfedges[edgeStart] = triangle;
+
+        // Connect to the further visible hull edges forward and backward, their cities leave the hull
+        uint32_t edgeEnd = m_hullNext[edgeStart];
+        for (uint32_t next = m_hullNext[edgeEnd]; isVisible(edgeEnd, next, x, y); next = m_hullNext[edgeEnd])
+        {
+            triangle = addTriangle(edgeEnd, city, next, m_hullHalfedges[city], INVALID_HALFEDGE, m_hullHalfedges[edgeEnd]);
+            m_hullHalfedges[city] = legalize(triangle + 2);
+            m_hullNext[edgeEnd] = edgeEnd;
+            edgeEnd = next;
+        }
+
+        if (edgeStart == start)
+        {
+            for (uint32_t previous = m_hullPrevious[edgeStart]; isVisible(previous, edgeStart, x, y); previous = m_hullPrevious[edgeStart])
+            {
+                triangle = addTriangle(previous, city, edgeStart, INVALID_HALFEDGE, m_hullHalfedges[edgeStart], m_hullHalfedges[previous]);
+                legalize(triangle + 2);
+                m_hullHalfedges[previous] = triangle;
+                m_hullNext[edgeStart] = edgeStart;
+                edgeStart = previous;
+            }
+        }
+
+        m_hullStart = edgeStart;
+        m_hullPrevious[city] = edgeStart;
+        m_hullNext[edgeStart] = city;
+        m_hullPrevious[edgeEnd] = city;
+        m_hullNext[city] = edgeEnd;
+
+        m_hullHash[getHullHashKey(x, y)] = city;
+        m_hullHash[getHullHashKey(coordinates.getX(edgeStart), coordinates.getY(edgeStart))] = edgeStart;
+    }
+
+    buildAdjacency(extraEdges);
+
+    m_hullPrevious = std::vector<uint32_t>();
+    m_hullNext = std::vector<uint32_t>();
+    m_hullHalfedges = std::vector<uint32_t>();
+    m_hullHash = std::vector<uint32_t>();
+}
+
+uint32_t DelaunayTriangulation::addTriangle(uint32_t first, uint32_t second, uint32_t third,
+    uint32_t firstOpposite, uint32_t secondOpposite, uint32_t thirdOpposite)
+{
+    const uint32_t halfedge = m_triangles.size();
+    m_triangles.push_back(first);
+    m_triangles.push_back(second);
+    m_triangles.push_back(third);
+    m_halfedges.resize(halfedge + 3);
+    link(halfedge, firstOpposite);
+    link(halfedge + 1, secondOpposite);
+    link(halfedge + 2, thirdOpposite);
+    return halfedge;
+}
+
+void DelaunayTriangulation::link(uint32_t halfedge, uint32_t opposite)
+{
+    m_halfedges[halfedge] = opposite;
+    if (opposite != INVALID_HALFEDGE)
+    {
+        m_halfedges[opposite] = halfedge;
+    }
+}
+
+uint32_t DelaunayTriangulation::legalize(uint32_t halfedge)
+{
+    /*
+     * Halfedge a of triangle (pr, pl, p0) and its opposite b of triangle (pl, pr, p1): when p1 lies inside the circle
+     * of the first triangle, the edge pr-pl is replaced by p0-p1 and the two edges now facing p1 are checked next
+     *
+     *           pl                    pl
+     *          /||\                  /  \
+     *       al/ || \bl            al/    \a
+     *        /  ||  \              /      \
+     *       /  a||b  \    flip    /___ar___\
+     *     p0\   ||   /p1   =>   p0\---bl---/p1
+     *        \  ||  /              \      /
+     *       ar\ || /br             b\    /br
+     *          \||/                  \  /
+     *           pr                    pr
+     */
+    const CityCoordinates& coordinates = *m_coordinates;
+    uint32_t a = halfedge;
+    uint32_t ar = 0;
+    m_flipStack.clear();
+
+    while (true)
+    {
+        const uint32_t b = m_halfedges[a];
+        const uint32_t a0 = a - a % 3;
+        ar = a0 + (a + 2) % 3;
+
+        if (b == INVALID_HALFEDGE)
+        {
+            if (m_flipStack.empty())
+            {
+                break;
+            }
+            a = m_flipStack.back();
+            m_flipStack.pop_back();
+            continue;
+        }
+
+        const uint32_t b0 = b - b % 3;
+        const uint32_t al = a0 + (a + 1) % 3;
+        const uint32_t bl = b0 + (b + 2) % 3;
+
+        const uint32_t p0 = m_triangles[ar];
+        const uint32_t pr = m_triangles[a];
+        const uint32_t pl = m_triangles[al];
+        const uint32_t p1 = m_triangles[bl];
+
+        const bool isIllegal = GeometricPredicates::inCircle(coordinates.getX(p0), coordinates.getY(p0), coordinates.getX(pr), coordinates.getY(pr),
+            coordinates.getX(pl), coordinates.getY(pl), coordinates.getX(p1), coordinates.getY(p1)) > 0;
+
+        if (!isIllegal)
+        {
+            if (m_flipStack.empty())
+            {
+                break;
+            }
+            a = m_flipStack.back();
+            m_flipStack.pop_back();
+            continue;
+        }
+
+        m_triangles[a] = p1;
+        m_triangles[b] = p0;
+
+        // The flip moved a hull edge from halfedge bl to halfedge a
+        const uint32_t hbl = m_halfedges[bl];
+        if (hbl == INVALID_HALFEDGE)
+        {
+            uint32_t hullCity = m_hullStart;
+            do
+            {
+                if (m_hullHalfedges[hullCity] == bl)
+                {
+                    m_hullHalfedges[hullCity] = a;
+                    break;
+                }
+                hullCity = m_hullPrevious[hullCity];
+            } while (hullCity != m_hullStart);
+        }
+        link(a, hbl);
+        link(b, m_halfedges[ar]);
+        link(ar, bl);
+
+        m_flipStack.push_back(b0 + (b + 1) % 3);
+    }
+
+    return ar;
+}
+
+uint32_t DelaunayTriangulation::getHullHashKey(float x, float y) const
+{
+    const uint32_t hashSize = m_hullHash.size();
+    return static_cast<uint32_t>(std::floor(getPseudoAngle(x - m_centerX, y - m_centerY) * hashSize)) % hashSize;
+}
+
+bool DelaunayTriangulation::isVisible(uint32_t first, uint32_t second, float x, float y) const
+{
+    const CityCoordinates& coordinates = *m_coordinates;
+    return GeometricPredicates::orientation(coordinates.getX(first), coordinates.getY(first), coordinates.getX(second), coordinates.getY(second), x, y) < 0;
+}
+
+void DelaunayTriangulation::buildAdjacency(const std::vector<uint32_t>& extraEdges)
+{
+    const uint32_t numberOfCities = m_coordinates->size();
+
+    // Every undirected edge once: from the halfedge with the smaller index, or the only one on the hull
+    auto forEachEdge = [&](auto visit)
+    {
+        for (uint32_t halfedge = 0; halfedge < m_triangles.size(); ++halfedge)
+        {
+            if (m_halfedges[halfedge] == INVALID_HALFEDGE || halfedge < m_halfedges[halfedge])
+            {
+                visit(m_triangles[halfedge], m_triangles[getNextHalfedge(halfedge)]);
+            }
+        }
+        for (size_t i = 0; i < extraEdges.size(); i += 2)
+        {
+            visit(extraEdges[i], extraEdges[i + 1]);
+        }
+    };
+
+    m_offsets.assign(numberOfCities + 1, 0);
+    forEachEdge([&](uint32_t first, uint32_t second)
+        {
+            ++m_offsets[first + 1];
+            ++m_offsets[second + 1];
+        });
+    std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+    m_neighbors.resize(m_offsets.back());
+    std::vector<uint32_t> nextSlots(m_offsets.begin(), m_offsets.end() - 1);
+    forEachEdge([&](uint32_t first, uint32_t second)
+        {
+            m_neighbors[nextSlots[first]++] = second;
+            m_neighbors[nextSlots[second]++] = first;
+        });
+}
@@ -0,0 +1,29 @@
+#include "DisjointSets.h"
+
+#include <numeric>
+#include <utility>
+
+void DisjointSets::reset(uint32_t numberOfElements)
+{
+    m_parents.resize(numberOfElements);
+    std::iota(m_parents.begin(), m_parents.end(), 0);
+    m_sizes.assign(numberOfElements, 1);
+}
+
+bool DisjointSets::unite(uint32_t first, uint32_t second)
+{
+    first = find(first);
+    second = find(second);
+    if (first == second)
+    {
+        return false;
+    }
+
+    if (m_sizes[first] < m_sizes[second])
+    {
+        std::swap(first, second);
+    }
+    m_parents[second] = first;
+    m_sizes[first] += m_sizes[second];
+    return true;
+}
@@ -0,0 +1,174 @@
+#include "GeometricPredicates.h"
+
+#include <vector>
+#include <cmath>
+
+namespace
+{
+    // Half the distance between 1 and the next double, the unit roundoff of Shewchuk's error bounds
+    constexpr double EPSILON = 1.1102230246251565e-16;
+    constexpr double ORIENTATION_ERROR_BOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+    constexpr double IN_CIRCLE_ERROR_BOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+
+    // A number represented exactly as the sum of nonoverlapping doubles of increasing magnitude, zeros left out
+    using Expansion = std::vector<double>;
+
+    void twoSum(double a, double b, double& sum, double& error)
+    {
+        sum = a + b;
+        const double bVirtual = sum - a;
+        const double aVirtual = sum - bVirtual;
+        error = (a - aVirtual) + (b - bVirtual);
+    }
+
+    void twoProduct(double a, double b, double& product, double& error)
+    {
+        product = a * b;
+        error = std::fma(a, b, -product);
+    }
+
+    // Adds a double to an expansion
+    void grow(Expansion& expansion, double value)
+    {
+        size_t size = 0;
+        for (double component : expansion)
+        {
+            double error;
+            twoSum(value, component, value, error);
+            if (error != 0.0)
+            {
+                expansion[size++] = error;
+            }
+        }
+        expansion.resize(size);
+        if (value != 0.0)
+        {
+            expansion.push_back(value);
+        }
+    }
+
+    void add(Expansion& sum, const Expansion& expansion, double sign)
+    {
+        for (double component : expansion)
+        {
+            grow(sum, sign * component);
+        }
+    }
+
+    Expansion multiply(const Expansion& first, const Expansion& second)
+    {
+        Expansion product;
+        for (double a : first)
+        {
+            for (double b : second)
+            {
+                double high;
+                double low;
+                twoProduct(a, b, high, low);
+                grow(product, low);
+                grow(product, high);
+            }
+        }
+        return product;
+    }
+
+    int getSign(const Expansion& expansion)
+    {
+        if (expansion.empty())
+        {
+            return 0;
+        }
+        return expansion.back() > 0.0 ? 1 : -1;
+    }
+
+    int getSign(double value)
+    {
+        return value > 0.0 ? 1 : (value < 0.0 ? -1 : 0);
+    }
+
+    // Products of two floats are exact in double precision, so these are exact two term expansions
+    Expansion getCrossProduct(double px, double py, double qx, double qy)
+    {
+        Expansion cross;
+        grow(cross, px * qy);
+        grow(cross, -(py * qx));
+        return cross;
+    }
+
+    Expansion getLift(double px, double py)
+    {
+        Expansion lift;
+        grow(lift, px * px);
+        grow(lift, py * py);
+        return lift;
+    }
+
+    // Determinant of the rows (x, y, x^2 + y^2) of p, q, r
+    Expansion getLiftedDeterminant(double px, double py, double qx, double qy, double rx, double ry)
+    {
+        Expansion determinant;
+        add(determinant, multiply(getLift(px, py), getCrossProduct(qx, qy, rx, ry)), 1.0);
+        add(determinant, multiply(getLift(qx, qy), getCrossProduct(px, py, rx, ry)), -1.0);
+        add(determinant, multiply(getLift(rx, ry), getCrossProduct(px, py, qx, qy)), 1.0);
+        return determinant;
+    }
+}
+
+int GeometricPredicates::orientation(float ax, float ay, float bx, float by, float cx, float cy)
+{
+    const double left = (static_cast<double>(ax) - cx) * (static_cast<double>(by) - cy);
+    const double right = (static_cast<double>(ay) - cy) * (static_cast<double>(bx) - cx);
+    const double determinant = left - right;
+    if (std::abs(determinant) > ORIENTATION_ERROR_BOUND * (std::abs(left) + std::abs(right)))
+    {
+        return getSign(determinant);
+    }
+
+    // ax * by - ax * cy - ay * bx + ay * cx + bx * cy - by * cx with every product exact
+    Expansion exact;
+    grow(exact, static_cast<double>(ax) * by);
+    grow(exact, -(static_cast<double>(ax) * cy));
+    grow(exact, -(static_cast<double>(ay) * bx));
+    grow(exact, static_cast<double>(ay) * cx);
+    grow(exact, static_cast<double>(bx) * cy);
+    grow(exact, -(static_cast<double>(by) * cx));
+    return getSign(exact);
+}
+
+int GeometricPredicates::inCircle(float ax, float ay, float bx, float by, float cx, float cy, float dx, float dy)
+{
+    const double adx = static_cast<double>(ax) - dx;
+    const double ady = static_cast<double>(ay) - dy;
+    const double bdx = static_cast<double>(bx) - dx;
+    const double bdy = static_cast<double>(by) - dy;
+    const double cdx = static_cast<double>(cx) - dx;
+    const double cdy = static_cast<double>(cy) - dy;
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+
+    const double aLift = adx * adx + ady * ady;
+    const double bLift = bdx * bdx + bdy * bdy;
+    const double cLift = cdx * cdx + cdy * cdy;
+
+    const double determinant = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+    const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift
+        + (std::abs(cdxady) + std::abs(adxcdy)) * bLift
+        + (std::abs(adxbdy) + std::abs(bdxady)) * cLift;
+    if (std::abs(determinant) > IN_CIRCLE_ERROR_BOUND * permanent)
+    {
+        return getSign(determinant);
+    }
+
+    // The same determinant with the points lifted to (x, y, x^2 + y^2, 1) untranslated, expanded along the column of ones
+    Expansion exact;
+    add(exact, getLiftedDeterminant(bx, by, cx, cy, dx, dy), -1.0);
+    add(exact, getLiftedDeterminant(ax, ay, cx, cy, dx, dy), 1.0);
+    add(exact, getLiftedDeterminant(ax, ay, bx, by, dx, dy), -1.0);
+    add(exact, getLiftedDeterminant(ax, ay, bx, by, cx, cy), 1.0);
+    return getSign(exact);
+}
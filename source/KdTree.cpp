@@ -0,0 +1,272 @@
+#include "KdTree.h"
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+void KdTree::build(const CityCoordinates& coordinates)
+{
+    m_coordinates = &coordinates;
+
+    m_cities.resize(coordinates.size());
+    std::iota(m_cities.begin(), m_cities.end(), 0);
+
+    m_nodes.clear();
+    m_nodes.reserve(2 * (coordinates.size() / LEAF_SIZE + 1));
+
+    m_positions.resize(coordinates.size());
+    m_leaves.resize(coordinates.size());
+
+    if (!m_cities.empty())
+    {
+        buildNode(0, m_cities.size(), INVALID_NODE);
+    }
+}
+
+uint32_t KdTree::buildNode(uint32_t begin, uint32_t end, uint32_t parent)
+{
+    const uint32_t nodeIndex = m_nodes.size();
+    m_nodes.push_back({ begin, end, INVALID_NODE, INVALID_NODE, parent, end - begin, 0.0f, 0 });
+
+    if (end - begin <= LEAF_SIZE)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            m_positions[m_cities[i]] = i;
+            m_leaves[m_cities[i]] = nodeIndex;
+        }
+        return nodeIndex;
+    }
+
+    float xMin = m_coordinates->getX(m_cities[begin]), xMax = xMin;
+    float yMin = m_coordinates->getY(m_cities[begin]), yMax = yMin;
+    for (uint32_t i = begin + 1; i < end; ++i)
+    {
+        const float x = m_coordinates->getX(m_cities[i]);
+        const float y = m_coordinates->getY(m_cities[i]);
+        xMin = std::min(xMin, x);
+        xMax = std::max(xMax, x);
+        yMin = std::min(yMin, y);
+        yMax = std::max(yMax, y);
+    }
+
+    const uint8_t splitDimension = (xMax - xMin) >= (yMax - yMin) ? 0 : 1;
+    const float* values = splitDimension == 0 ? m_coordinates->getXs() : m_coordinates->getYs();
+
+    const uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(m_cities.begin() + begin, m_cities.begin() + middle, m_cities.begin() + end,
+        [values](uint32_t a, uint32_t b) { return values[a] < values[b]; });
+    // Read before the children reorder the range
+    const float splitValue = values[m_cities[middle]];
+
+    const uint32_t lowerChild = buildNode(begin, middle, nodeIndex);
+    const uint32_t upperChild = buildNode(middle, end, nodeIndex);
+
+    Node& node = m_nodes[nodeIndex];
+    node.lowerChild = lowerChild;
+    node.upperChild = upperChild;
+    node.splitValue = splitValue;
+    node.splitDimension = splitDimension;
+
+    return nodeIndex;
+}
+
+uint32_t KdTree::findNearestNeighbors(uint32_t city, uint32_t k, uint32_t* neighbors, float* squaredDistances) const
+{
+    if (m_nodes.empty() || k == 0)
+    {
+        return 0;
+    }
+
+    const float queryX = m_coordinates->getX(city);
+    const float queryY = m_coordinates->getY(city);
+
+    uint32_t count = 0;
+
+    // Explicit stack of nodes still to visit together with a lower bound of their squared distance to the query
+    struct PendingNode
+    {
+        uint32_t node;
+        float squaredDistanceBound;
+    };
+    PendingNode stack[64];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = { 0, 0.0f };
+
+    while (stackSize > 0)
+    {
+        const PendingNode pending = stack[--stackSize];
+        if (count == k && pending.squaredDistanceBound >= squaredDistances[k - 1])
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[pending.node];
+        if (node.lowerChild == INVALID_NODE)
+        {
+            for (uint32_t i = node.begin; i < node.end; ++i)
+            {
+                const uint32_t candidate = m_cities[i];
+                if (candidate == city)
+                {
+                    continue;
+                }
+
+                const float squaredDistance = m_coordinates->getSquaredDistance(city, candidate);
+                if (count == k && squaredDistance >= squaredDistances[k - 1])
+                {
+                    continue;
+                }
+
+                // Insertion into the sorted result buffers
+                uint32_t position = count < k ? count++ : k - 1;
+                while (position > 0 && squaredDistances[position - 1] > squaredDistance)
+                {
+                    squaredDistances[position] = squaredDistances[position - 1];
+                    neighbors[position] = neighbors[position - 1];
+                    --position;
+                }
+                squaredDistances[position] = squaredDistance;
+                neighbors[position] = candidate;
+            }
+            continue;
+        }
+
+        const float queryValue = node.splitDimension == 0 ? queryX : queryY;
+        const float splitDistance = queryValue - node.splitValue;
+        const float farBound = std::max(pending.squaredDistanceBound, splitDistance * splitDistance);
+
+        // The nearer child is pushed last so it is visited first
+        if (splitDistance < 0.0f)
+        {
+            stack[stackSize++] = { node.upperChild, farBound };
+            stack[stackSize++] = { node.lowerChild, pending.squaredDistanceBound };
+        }
+        else
+        {
+            stack[stackSize++] = { node.lowerChild, farBound };
+            stack[stackSize++] = { node.upperChild, pending.squaredDistanceBound };
+        }
+    }
+
+    return count;
+}
+
+void KdTree::resetRemaining()
+{
+    for (Node& node : m_nodes)
+    {
+        node.numberOfRemaining = node.end - node.begin;
+    }
+}
+
+void KdTree::removeCity(uint32_t city)
+{
+    if (!isRemaining(city))
+    {
+        return;
+    }
+
+    // Swap the city behind the remaining ones of its leaf
+    Node& leaf = m_nodes[m_leaves[city]];
+    const uint32_t position = m_positions[city];
+    const uint32_t lastPosition = leaf.begin + leaf.numberOfRemaining - 1;
+    const uint32_t lastCity = m_cities[lastPosition];
+
+    m_cities[position] = lastCity;
+    m_positions[lastCity] = position;
+    m_cities[lastPosition] = city;
+    m_positions[city] = lastPosition;
+
+    for (uint32_t node = m_leaves[city]; node != INVALID_NODE; node = m_nodes[node].parent)
+    {
+        --m_nodes[node].numberOfRemaining;
+    }
+}
+
+void KdTree::restoreCity(uint32_t city)
+{
+    if (isRemaining(city))
+    {
+        return;
+    }
+
+    // Swap the city to the front of the removed ones of its leaf
+    Node& leaf = m_nodes[m_leaves[city]];
+    const uint32_t position = m_positions[city];
+    const uint32_t firstRemovedPosition = leaf.begin + leaf.numberOfRemaining;
+    const uint32_t firstRemovedCity = m_cities[firstRemovedPosition];
+
+    m_cities[position] = firstRemovedCity;
+    m_positions[firstRemovedCity] = position;
+    m_cities[firstRemovedPosition] = city;
+    m_positions[city] = firstRemovedPosition;
+
+    for (uint32_t node = m_leaves[city]; node != INVALID_NODE; node = m_nodes[node].parent)
+    {
+        ++m_nodes[node].numberOfRemaining;
+    }
+}
+
+uint32_t KdTree::findNearestRemaining(float x, float y) const
+{
+    if (m_nodes.empty() || m_nodes[0].numberOfRemaining == 0)
+    {
+        return INVALID_CITY;
+    }
+
+    uint32_t nearestCity = INVALID_CITY;
+    float nearestSquaredDistance = std::numeric_limits<float>::infinity();
+
+    struct PendingNode
+    {
+        uint32_t node;
+        float squaredDistanceBound;
+    };
+    PendingNode stack[64];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = { 0, 0.0f };
+
+    while (stackSize > 0)
+    {
+        const PendingNode pending = stack[--stackSize];
+        const Node& node = m_nodes[pending.node];
+        if (node.numberOfRemaining == 0 || pending.squaredDistanceBound >= nearestSquaredDistance)
+        {
+            continue;
+        }
+
+        if (node.lowerChild == INVALID_NODE)
+        {
+            for (uint32_t i = node.begin; i < node.begin + node.numberOfRemaining; ++i)
+            {
+                const float dx = m_coordinates->getX(m_cities[i]) - x;
+                const float dy = m_coordinates->getY(m_cities[i]) - y;
+                const float squaredDistance = dx * dx + dy * dy;
+                if (squaredDistance < nearestSquaredDistance)
+                {
+                    nearestSquaredDistance = squaredDistance;
+                    nearestCity = m_cities[i];
+                }
+            }
+            continue;
+        }
+
+        const float splitDistance = (node.splitDimension == 0 ? x : y) - node.splitValue;
+        const float farBound = std::max(pending.squaredDistanceBound, splitDistance * splitDistance);
+
+        // The nearer child is pushed last so it is visited first
+        if (splitDistance < 0.0f)
+        {
+            stack[stackSize++] = { node.upperChild, farBound };
+            stack[stackSize++] = { node.lowerChild, pending.squaredDistanceBound };
+        }
+        else
+        {
+            stack[stackSize++] = { node.lowerChild, farBound };
+            stack[stackSize++] = { node.upperChild, pending.squaredDistanceBound };
+        }
+    }
+
+    return nearestCity;
+}
@@ -1,6 +1,5 @@
 #include "Shader.h"
 #include "TravelingSalesmanSolver.h"
-#include "Point2D.h"
 #include "SolverColors.h"
 
 #include <glad/glad.h>
@@ -204,17 +203,18 @@ int main()
 		unsigned int pointIndexCount = 0;
 
 		{
-			const std::vector<Point2D>& points = solver.getPoints();
+			const CityCoordinates& coordinates = solver.getCoordinates();
+			const VisualizationBuffer& visualization = solver.getVisualization();
 
 			std::array<PointVertex, MAX_POINTS_VERTEX_COUNT> pointVertices;
 			PointVertex* buffer = pointVertices.data();
 
-			for (const Point2D& point : points)
+			for (uint32_t city = 0; city < coordinates.size(); ++city)
 			{
-				const float pointLowerLeftX = point.getX() - pointRadius;
-				const float pointLowerLeftY = point.getY() - pointRadius;
+				const float pointLowerLeftX = coordinates.getX(city) - pointRadius;
+				const float pointLowerLeftY = coordinates.getY(city) - pointRadius;
 
-				buffer = createRectangle(buffer, pointLowerLeftX, pointLowerLeftY, pointRadius * 2, pointRadius * 2, point.getColor());
+				buffer = createRectangle(buffer, pointLowerLeftX, pointLowerLeftY, pointRadius * 2, pointRadius * 2, visualization.getPointColor(city));
 				pointIndexCount += 6;
 			}
 
@@ -226,16 +226,32 @@ int main()
 		unsigned int routeVertexCount = 0;
 
 		{
-			const std::vector<Point2D*>& route = solver.getRoute();
-			int routeLength = route.size();
+			const CityCoordinates& coordinates = solver.getCoordinates();
+			const VisualizationBuffer& visualization = solver.getVisualization();
+			const Route& route = solver.getRoute();
+			const std::vector<uint32_t>& routeCities = route.getCities();
+			int routeLength = routeCities.size();
 
 			std::array<LineVertex, MAX_LINES_VERTEX_COUNT> routeVertices;
 			LineVertex* buffer = routeVertices.data();
 
 			for (int i = 0; i < routeLength - 1; ++i)
 			{
-				buffer = createLine(buffer, route.at(i)->getX(), route.at(i)->getY(),
-					route.at(i + 1)->getX(), route.at(i + 1)->getY(), route.at(i)->getOutgoingLineColor());
+				const uint32_t startCity = routeCities[i];
+				const uint32_t endCity = routeCities[i + 1];
+
+				buffer = createLine(buffer, coordinates.getX(startCity), coordinates.getY(startCity),
+					coordinates.getX(endCity), coordinates.getY(endCity), visualization.getOutgoingLineColor(startCity));
+				routeVertexCount += 2;
+			}
+
+			if (route.isComplete() && routeLength > 1)
+			{
+				const uint32_t startCity = routeCities[routeLength - 1];
+				const uint32_t endCity = routeCities[0];
+
+				buffer = createLine(buffer, coordinates.getX(startCity), coordinates.getY(startCity),
+					coordinates.getX(endCity), coordinates.getY(endCity), visualization.getOutgoingLineColor(startCity));
 				routeVertexCount += 2;
 			}
 
@@ -299,13 +315,41 @@ int main()
 			ImGui::NewLine();
 
 			if (ImGui::RadioButton("Greedy algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::GREEDY) ||
-				ImGui::RadioButton("2-Opt algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::TWO_OPT))
+				ImGui::RadioButton("Greedy edge algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::GREEDY_EDGE) ||
+				ImGui::RadioButton("Savings algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::SAVINGS) ||
+				ImGui::RadioButton("Double tree algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::DOUBLE_TREE) ||
+				ImGui::RadioButton("Christofides algorithm (greedy matching)", &selectedAlgorithmIndex, SolvingAlgorithm::CHRISTOFIDES) ||
+				ImGui::RadioButton("Space-filling curve algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::SPACE_FILLING_CURVE) ||
+				ImGui::RadioButton("Cheapest insertion algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::CHEAPEST_INSERTION) ||
+				ImGui::RadioButton("Nearest insertion algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::NEAREST_INSERTION) ||
+				ImGui::RadioButton("Farthest insertion algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::FARTHEST_INSERTION) ||
+				ImGui::RadioButton("Convex hull insertion algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::CONVEX_HULL_INSERTION) ||
+				ImGui::RadioButton("2-Opt algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::TWO_OPT) ||
+				ImGui::RadioButton("2-Opt algorithm (neighbor lists)", &selectedAlgorithmIndex, SolvingAlgorithm::TWO_OPT_NEIGHBOR_LIST) ||
+				ImGui::RadioButton("Or-Opt algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::OR_OPT) ||
+				ImGui::RadioButton("2-Opt + Or-Opt algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::TWO_OPT_OR_OPT) ||
+				ImGui::RadioButton("Lin-Kernighan algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::LIN_KERNIGHAN) ||
+				ImGui::RadioButton("Simulated annealing", &selectedAlgorithmIndex, SolvingAlgorithm::SIMULATED_ANNEALING) ||
+				ImGui::RadioButton("Parallel tempering", &selectedAlgorithmIndex, SolvingAlgorithm::PARALLEL_TEMPERING) ||
+				ImGui::RadioButton("Iterated local search", &selectedAlgorithmIndex, SolvingAlgorithm::ITERATED_LOCAL_SEARCH) ||
+				ImGui::RadioButton("Genetic algorithm", &selectedAlgorithmIndex, SolvingAlgorithm::GENETIC_ALGORITHM) ||
+				ImGui::RadioButton("Ant colony", &selectedAlgorithmIndex, SolvingAlgorithm::ANT_COLONY))
 			{
 				solver.setSolvingAlgorithm(SolvingAlgorithm(selectedAlgorithmIndex));
 			}
 
 			ImGui::NewLine();
 
+			int distanceModeIndex = solver.getDistanceMode();
+			if (ImGui::RadioButton("Euclidean distance", &distanceModeIndex, DistanceMode::EUCLIDEAN) ||
+				ImGui::RadioButton("Rounded distance (nint)", &distanceModeIndex, DistanceMode::ROUNDED_EUCLIDEAN) ||
+				ImGui::RadioButton("Rounded distance (ceil)", &distanceModeIndex, DistanceMode::CEILED_EUCLIDEAN))
+			{
+				solver.setDistanceMode(DistanceMode(distanceModeIndex));
+			}
+
+			ImGui::NewLine();
+
 			ImGui::Text("Route length: %.3f", solver.getRouteLength());
 
 			ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
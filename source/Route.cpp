@@ -0,0 +1,122 @@
+#include "Route.h"
+
+#include <algorithm>
+#include <array>
+
+void Route::reset(uint32_t numberOfCities)
+{
+    m_cities.clear();
+    if (m_cities.capacity() < numberOfCities)
+    {
+        m_cities.reserve(numberOfCities);
+    }
+
+    m_positions.assign(numberOfCities, INVALID_POSITION);
+}
+
+void Route::append(uint32_t city)
+{
+    m_positions[city] = m_cities.size();
+    m_cities.push_back(city);
+}
+
+void Route::reverse(uint32_t firstPosition, uint32_t lastPosition)
+{
+    while (firstPosition < lastPosition)
+    {
+        const uint32_t firstCity = m_cities[lastPosition];
+        const uint32_t lastCity = m_cities[firstPosition];
+
+        m_cities[firstPosition] = firstCity;
+        m_cities[lastPosition] = lastCity;
+        m_positions[firstCity] = firstPosition;
+        m_positions[lastCity] = lastPosition;
+
+        ++firstPosition;
+        --lastPosition;
+    }
+}
+
+void Route::reverseCyclic(uint32_t firstPosition, uint32_t lastPosition)
+{
+    const uint32_t numberOfCities = m_cities.size();
+
+    uint32_t segmentLength = (lastPosition + numberOfCities - firstPosition) % numberOfCities + 1;
+    if (2 * segmentLength > numberOfCities)
+    {
+        const uint32_t complementFirstPosition = lastPosition + 1 == numberOfCities ? 0 : lastPosition + 1;
+        const uint32_t complementLastPosition = firstPosition == 0 ? numberOfCities - 1 : firstPosition - 1;
+
+        firstPosition = complementFirstPosition;
+        lastPosition = complementLastPosition;
+        segmentLength = numberOfCities - segmentLength;
+    }
+
+    for (uint32_t swaps = segmentLength / 2; swaps > 0; --swaps)
+    {
+        const uint32_t firstCity = m_cities[lastPosition];
+        const uint32_t lastCity = m_cities[firstPosition];
+
+        m_cities[firstPosition] = firstCity;
+        m_cities[lastPosition] = lastCity;
+        m_positions[firstCity] = firstPosition;
+        m_positions[lastCity] = lastPosition;
+
+        firstPosition = firstPosition + 1 == numberOfCities ? 0 : firstPosition + 1;
+        lastPosition = lastPosition == 0 ? numberOfCities - 1 : lastPosition - 1;
+    }
+}
+
+void Route::moveSegment(uint32_t segmentFirstPosition, uint32_t segmentLength, uint32_t targetCity, bool isReversed)
+{
+    const uint32_t numberOfCities = m_cities.size();
+    auto wrap = [numberOfCities](uint32_t position) { return position >= numberOfCities ? position - numberOfCities : position; };
+
+    std::array<uint32_t, MAX_MOVED_SEGMENT_LENGTH> segment;
+    for (uint32_t i = 0; i < segmentLength; ++i)
+    {
+        segment[i] = m_cities[wrap(segmentFirstPosition + i)];
+    }
+    if (isReversed)
+    {
+        std::reverse(segment.begin(), segment.begin() + segmentLength);
+    }
+
+    const uint32_t segmentLastPosition = wrap(segmentFirstPosition + segmentLength - 1);
+    // Cities after the segment up to and including targetCity, and the ones from targetCity's successor up to the segment
+    const uint32_t forwardCount = wrap(m_positions[targetCity] + numberOfCities - segmentLastPosition);
+    const uint32_t backwardCount = numberOfCities - segmentLength - forwardCount;
+
+    uint32_t segmentNewFirstPosition;
+    if (forwardCount <= backwardCount)
+    {
+        // Shift the forward cities back into the gap left by the segment
+        for (uint32_t i = 0; i < forwardCount; ++i)
+        {
+            const uint32_t position = wrap(segmentFirstPosition + i);
+            const uint32_t city = m_cities[wrap(segmentLastPosition + 1 + i)];
+            m_cities[position] = city;
+            m_positions[city] = position;
+        }
+        segmentNewFirstPosition = wrap(segmentFirstPosition + forwardCount);
+    }
+    else
+    {
+        // Shift the backward cities forward into the gap, starting with the one right before the segment
+        for (uint32_t i = 0; i < backwardCount; ++i)
+        {
+            const uint32_t position = wrap(segmentLastPosition + numberOfCities - i);
+            const uint32_t city = m_cities[wrap(segmentFirstPosition + numberOfCities - 1 - i)];
+            m_cities[position] = city;
+            m_positions[city] = position;
+        }
+        segmentNewFirstPosition = wrap(segmentFirstPosition + numberOfCities - backwardCount);
+    }
+
+    for (uint32_t i = 0; i < segmentLength; ++i)
+    {
+        const uint32_t position = wrap(segmentNewFirstPosition + i);
+        m_cities[position] = segment[i];
+        m_positions[segment[i]] = position;
+    }
+}
@@ -0,0 +1,53 @@
+#include "RouteLength.h"
+
+void RouteLength::reset(const CityCoordinates& coordinates)
+{
+    m_isInteger = coordinates.isIntegerDistanceMode();
+    m_integerLength = 0;
+    m_length = 0.0;
+    m_numberOfUpdates = 0;
+}
+
+void RouteLength::recompute(const CityCoordinates& coordinates, const Route& route)
+{
+    reset(coordinates);
+
+    const uint32_t numberOfEdges = route.isComplete() ? route.size() : (route.isEmpty() ? 0 : route.size() - 1);
+    for (uint32_t i = 0; i < numberOfEdges; ++i)
+    {
+        const float distance = coordinates.getDistance(route.at(i), route.at(i + 1 == route.size() ? 0 : i + 1));
+        if (m_isInteger)
+        {
+            m_integerLength += static_cast<int64_t>(distance);
+        }
+        else
+        {
+            m_length += distance;
+        }
+    }
+
+    m_numberOfUpdates = 0;
+}
+
+void RouteLength::recompute(const CityCoordinates& coordinates, const TwoLevelTour& tour)
+{
+    reset(coordinates);
+
+    uint32_t city = 0;
+    for (uint32_t i = 0; i < tour.getNumberOfCities(); ++i)
+    {
+        const uint32_t nextCity = tour.next(city);
+        const float distance = coordinates.getDistance(city, nextCity);
+        if (m_isInteger)
+        {
+            m_integerLength += static_cast<int64_t>(distance);
+        }
+        else
+        {
+            m_length += distance;
+        }
+        city = nextCity;
+    }
+
+    m_numberOfUpdates = 0;
+}
@@ -0,0 +1,61 @@
+#include "SpaceFillingCurve.h"
+
+#include <algorithm>
+#include <utility>
+
+uint32_t SpaceFillingCurve::getHilbertIndex(uint32_t x, uint32_t y)
+{
+    // https://en.wikipedia.org/wiki/Hilbert_curve#Applications_and_mapping_algorithms
+    const uint32_t gridSize = 1u << GRID_ORDER;
+
+    uint32_t index = 0;
+    for (uint32_t half = gridSize / 2; half > 0; half /= 2)
+    {
+        const uint32_t isRight = (x & half) != 0 ? 1 : 0;
+        const uint32_t isUpper = (y & half) != 0 ? 1 : 0;
+        index += half * half * ((3 * isRight) ^ isUpper);
+
+        // Rotate the quadrant so the curve inside it has the base orientation
+        if (isUpper == 0)
+        {
+            if (isRight == 1)
+            {
+                x = gridSize - 1 - x;
+                y = gridSize - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+std::vector<uint32_t> SpaceFillingCurve::getHilbertOrder(const CityCoordinates& coordinates)
+{
+    const uint32_t numberOfCities = coordinates.size();
+    std::vector<uint32_t> order(numberOfCities);
+    if (numberOfCities == 0)
+    {
+        return order;
+    }
+
+    const auto [xMin, xMax] = std::minmax_element(coordinates.getXs(), coordinates.getXs() + numberOfCities);
+    const auto [yMin, yMax] = std::minmax_element(coordinates.getYs(), coordinates.getYs() + numberOfCities);
+    const double extent = std::max(static_cast<double>(*xMax) - *xMin, static_cast<double>(*yMax) - *yMin);
+    const double scale = extent > 0.0 ? ((1u << GRID_ORDER) - 1) / extent : 0.0;
+
+    // Curve index in the high half, city in the low half, so one integer sort orders them
+    std::vector<uint64_t> keys(numberOfCities);
+    for (uint32_t city = 0; city < numberOfCities; ++city)
+    {
+        const uint32_t x = static_cast<uint32_t>((coordinates.getX(city) - *xMin) * scale);
+        const uint32_t y = static_cast<uint32_t>((coordinates.getY(city) - *yMin) * scale);
+        keys[city] = (static_cast<uint64_t>(getHilbertIndex(x, y)) << 32) | city;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    for (uint32_t i = 0; i < numberOfCities; ++i)
+    {
+        order[i] = static_cast<uint32_t>(keys[i]);
+    }
+    return order;
+}
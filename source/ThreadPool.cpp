@@ -0,0 +1,88 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int numberOfThreads)
+{
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_threads.reserve(numberOfThreads - 1);
+    for (unsigned int worker = 1; worker < numberOfThreads; ++worker)
+    {
+        m_threads.emplace_back(&ThreadPool::work, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_roundStarted.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::run(uint32_t numberOfTasks, const std::function<void(uint32_t task, unsigned int worker)>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_numberOfTasks = numberOfTasks;
+        m_nextTask = 0;
+        m_numberOfBusyThreads = m_threads.size();
+        ++m_round;
+    }
+    m_roundStarted.notify_all();
+
+    runTasks(0);
+
+    // task has to outlive every worker still finishing its last call
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_roundFinished.wait(lock, [this]() { return m_numberOfBusyThreads == 0; });
+    m_task = nullptr;
+}
+
+void ThreadPool::work(unsigned int worker)
+{
+    uint64_t finishedRound = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_roundStarted.wait(lock, [&]() { return m_isStopping || m_round != finishedRound; });
+            if (m_isStopping)
+            {
+                return;
+            }
+            finishedRound = m_round;
+        }
+
+        runTasks(worker);
+
+        bool isLast;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            isLast = --m_numberOfBusyThreads == 0;
+        }
+        if (isLast)
+        {
+            m_roundFinished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks(unsigned int worker)
+{
+    for (uint32_t task = m_nextTask++; task < m_numberOfTasks; task = m_nextTask++)
+    {
+        (*m_task)(task, worker);
+    }
+}
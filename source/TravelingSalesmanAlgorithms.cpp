@@ -1,33 +1,129 @@
 #include "TravelingSalesmanAlgorithms.h"
 #include "SolverColors.h"
+#include "ActiveCityQueue.h"
+#include "TwoLevelTour.h"
+#include "TwoOptKernel.h"
+#include "UnvisitedCities.h"
+#include "KdTree.h"
+#include "DisjointSets.h"
+#include "SpaceFillingCurve.h"
+#include "FastRandom.h"
+#include "ThreadPool.h"
 
 #include <random>
 #include <limits>
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <cstdlib>
+#include <type_traits>
+#include <chrono>
+#include <cmath>
 #include <thread>
+#include <barrier>
+#include <array>
+#include <span>
 
-void TravelingSalesmanAlgorithms::greedyAlgorithm(const unsigned int& timeStepMilliseconds, const std::atomic<bool>& isInterrupt, 
-    std::vector<Point2D>& points, std::vector<Point2D*>& route, float& routeLength)
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::runAlgorithm(SolvingAlgorithm algorithm, Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength, const SearchSettings& settings)
 {
-    if (!route.empty())
+    switch (algorithm)
     {
-        route.clear();
-    }
-    if (route.capacity() < points.size() + 1)
-    {
-        route.reserve(points.size() + 1);
+    case GREEDY:
+        greedyAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+        break;
+    case TWO_OPT:
+        twoOptAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+        break;
+    case RANDOM_ROUTE:
+        randomRouteAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+        break;
+    case TWO_OPT_NEIGHBOR_LIST:
+        twoOptNeighborListAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        break;
+    case OR_OPT:
+        orOptAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        break;
+    case TWO_OPT_OR_OPT:
+        twoOptAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+        orOptAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        break;
+    case LIN_KERNIGHAN:
+        linKernighanAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        break;
+    case SIMULATED_ANNEALING:
+        simulatedAnnealingAlgorithm(visualization, isInterrupt, coordinates, candidateLists, settings, route, routeLength);
+        break;
+    case PARALLEL_TEMPERING:
+        parallelTemperingAlgorithm(visualization, isInterrupt, coordinates, candidateLists, settings, route, routeLength);
+        break;
+    case ITERATED_LOCAL_SEARCH:
+        iteratedLocalSearchAlgorithm(visualization, isInterrupt, coordinates, candidateLists, settings, route, routeLength);
+        break;
+    case GENETIC_ALGORITHM:
+        geneticAlgorithm(visualization, isInterrupt, coordinates, candidateLists, settings, route, routeLength);
+        break;
+    case ANT_COLONY:
+        antColonyAlgorithm(visualization, isInterrupt, coordinates, candidateLists, settings, route, routeLength);
+        break;
+    case GREEDY_EDGE:
+        greedyEdgeAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        break;
+    case SAVINGS:
+        savingsAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        break;
+    case DOUBLE_TREE:
+    case CHRISTOFIDES:
+        spanningTreeAlgorithm(algorithm, visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        break;
+    case SPACE_FILLING_CURVE:
+        spaceFillingCurveAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+        break;
+    case CHEAPEST_INSERTION:
+    case NEAREST_INSERTION:
+    case FARTHEST_INSERTION:
+    case CONVEX_HULL_INSERTION:
+        insertionAlgorithm(algorithm, visualization, isInterrupt, coordinates, route, routeLength);
+        break;
     }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::greedyAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt, 
+    const CityCoordinates& coordinates, Route& route, RouteLength& routeLength)
+{
+    route.reset(coordinates.size());
+
+    routeLength.reset(coordinates);
 
-    routeLength = 0;
+    const uint32_t startPointIndex = 0;
 
-    const int startPointIndex = 0;
+    uint32_t numberOfPoints = coordinates.size();
+
+    if (numberOfPoints == 0)
+    {
+        return;
+    }
 
-    int numberOfPoints = points.size();
-    std::vector<bool> isVisited(numberOfPoints, false);
+    // Small instances scan the compacted unvisited cities with SIMD, large ones query a kd-tree with deletion
+    const bool isUsingKdTree = numberOfPoints >= GREEDY_KD_TREE_MIN_NUMBER_OF_CITIES;
+    UnvisitedCities unvisitedCities;
+    KdTree kdTree;
+    if (isUsingKdTree)
+    {
+        kdTree.build(coordinates);
+        kdTree.removeCity(startPointIndex);
+    }
+    else
+    {
+        unvisitedCities.reset(coordinates);
+        unvisitedCities.remove(startPointIndex);
+    }
 
-    isVisited.at(startPointIndex) = true;
-    route.push_back(&points.at(startPointIndex));
+    route.append(startPointIndex);
 
-    points.at(startPointIndex).setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_A);
+    visualization.setOutgoingLineColor(startPointIndex, SolverColors::LINE_HIGHLIGHT_COLOR_A);
 
     while (route.size() < numberOfPoints)
     {
@@ -36,154 +132,2986 @@ void TravelingSalesmanAlgorithms::greedyAlgorithm(const unsigned int& timeStepMi
             return;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeStepMilliseconds));
+        visualization.waitTimeStep();
+
+        const uint32_t currentPointIndex = route.at(route.size() - 1);
+        const float currentX = coordinates.getX(currentPointIndex);
+        const float currentY = coordinates.getY(currentPointIndex);
+
+        uint32_t closestPointIndex;
+        if (isUsingKdTree)
+        {
+            closestPointIndex = kdTree.findNearestRemaining(currentX, currentY);
+            kdTree.removeCity(closestPointIndex);
+        }
+        else
+        {
+            closestPointIndex = unvisitedCities.findNearest(currentX, currentY);
+            unvisitedCities.remove(closestPointIndex);
+        }
+
+        route.append(closestPointIndex);
+        routeLength.add(coordinates.getDistance(currentPointIndex, closestPointIndex));
+
+        visualization.setOutgoingLineColor(closestPointIndex, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+    }
+
+    visualization.waitTimeStep();
+
+    routeLength.add(coordinates.getDistance(route.at(route.size() - 1), startPointIndex));
 
-        Point2D* currentPoint = route.back();
-        int closestPointIndex = -1;
-        
-        float minDistance = std::numeric_limits<float>::max();
-        for (int i = 0; i < numberOfPoints; ++i)
+    visualization.waitTimeStep(); 
+}
+
+namespace
+{
+    constexpr uint32_t NO_CITY = UINT32_MAX;
+
+    // Calls visit(first, second) for each undirected edge of the candidate graph once, also when only one of its cities lists the other
+    template <typename Visit>
+    void forEachCandidateEdge(const CandidateLists& candidateLists, Visit visit)
+    {
+        for (uint32_t city = 0; city < candidateLists.getNumberOfCities(); ++city)
         {
-            if (isVisited.at(i))
+            for (uint32_t candidate : candidateLists.getNeighbors(city))
             {
-                continue;
+                if (city > candidate)
+                {
+                    const std::span<const uint32_t> candidateNeighbors = candidateLists.getNeighbors(candidate);
+                    if (std::find(candidateNeighbors.begin(), candidateNeighbors.end(), city) != candidateNeighbors.end())
+                    {
+                        continue;
+                    }
+                }
+                visit(city, candidate);
             }
+        }
+    }
+
+    // Cities joined into paths by a construction, each with up to two path neighbors
+    class PathFragments
+    {
+        std::vector<uint32_t> m_neighbors;
+
+    public:
+        void reset(uint32_t numberOfCities) { m_neighbors.assign(2 * static_cast<size_t>(numberOfCities), NO_CITY); };
+
+        uint32_t getDegree(uint32_t city) const
+        {
+            return (m_neighbors[2 * city] != NO_CITY ? 1 : 0) + (m_neighbors[2 * city + 1] != NO_CITY ? 1 : 0);
+        };
+        // The path neighbor of city other than from, NO_CITY at the end of the path
+        uint32_t getNextOnPath(uint32_t city, uint32_t from) const
+        {
+            return m_neighbors[2 * city] != from ? m_neighbors[2 * city] : m_neighbors[2 * city + 1];
+        };
+
+        void addEdge(uint32_t first, uint32_t second)
+        {
+            m_neighbors[2 * first + (m_neighbors[2 * first] == NO_CITY ? 0 : 1)] = second;
+            m_neighbors[2 * second + (m_neighbors[2 * second] == NO_CITY ? 0 : 1)] = first;
+        };
+    };
+
+    // Appends the paths to an empty route one after another, continuing each time with the path endpoint
+    // nearest to where the previous path ended. Single cities count as paths. Returns false when interrupted.
+    template <typename Visualization>
+    bool joinPathFragments(Visualization& visualization, const std::atomic<bool>& isInterrupt, const CityCoordinates& coordinates,
+        const PathFragments& fragments, Route& route, RouteLength& routeLength)
+    {
+        const uint32_t numberOfCities = coordinates.size();
+
+        KdTree endpoints;
+        endpoints.build(coordinates);
+        uint32_t start = NO_CITY;
+        for (uint32_t city = 0; city < numberOfCities; ++city)
+        {
+            if (fragments.getDegree(city) == 2)
+            {
+                endpoints.removeCity(city);
+            }
+            else if (start == NO_CITY)
+            {
+                start = city;
+            }
+        }
 
-            const float distance = currentPoint->getDistanceToPoint(points.at(i));
+        uint32_t pathStart = start;
+        while (pathStart != KdTree::INVALID_CITY)
+        {
+            endpoints.removeCity(pathStart);
 
-            if (distance < minDistance)
+            uint32_t previous = NO_CITY;
+            uint32_t city = pathStart;
+            while (city != NO_CITY)
             {
-                minDistance = distance;
-                closestPointIndex = i;
+                if (isInterrupt)
+                {
+                    return false;
+                }
+
+                if (!route.isEmpty())
+                {
+                    routeLength.add(coordinates.getDistance(route.at(route.size() - 1), city));
+                }
+                route.append(city);
+
+                visualization.setOutgoingLineColor(city, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+                visualization.waitTimeStep();
+
+                const uint32_t next = fragments.getNextOnPath(city, previous);
+                previous = city;
+                city = next;
             }
+
+            endpoints.removeCity(previous);
+            pathStart = endpoints.findNearestRemaining(coordinates.getX(previous), coordinates.getY(previous));
         }
-        // TODO throw exception if closestNeighbourIndex is -1
-        route.push_back(&points.at(closestPointIndex));
-        isVisited.at(closestPointIndex) = true; 
-        routeLength += minDistance;
 
-        points.at(closestPointIndex).setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_A);
+        routeLength.add(coordinates.getDistance(route.at(route.size() - 1), start));
+        return true;
+    }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::greedyEdgeAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength)
+{
+    const uint32_t numberOfCities = coordinates.size();
+
+    route.reset(numberOfCities);
+    routeLength.reset(coordinates);
+
+    if (numberOfCities == 0)
+    {
+        return;
+    }
+
+    struct CandidateEdge
+    {
+        float squaredLength;
+        uint32_t first;
+        uint32_t second;
+    };
+
+    std::vector<CandidateEdge> edges;
+    edges.reserve(candidateLists.getNeighborArray().size());
+    forEachCandidateEdge(candidateLists, [&](uint32_t first, uint32_t second)
+    {
+        edges.push_back({ coordinates.getSquaredDistance(first, second), first, second });
+    });
+    std::sort(edges.begin(), edges.end(), [](const CandidateEdge& a, const CandidateEdge& b) { return a.squaredLength < b.squaredLength; });
+
+    if (isInterrupt)
+    {
+        return;
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(timeStepMilliseconds));
+    PathFragments fragments;
+    fragments.reset(numberOfCities);
+    DisjointSets paths;
+    paths.reset(numberOfCities);
+
+    // A tour has numberOfCities - 1 path edges before it is closed
+    uint32_t numberOfEdges = 0;
+    for (const CandidateEdge& edge : edges)
+    {
+        if (numberOfEdges + 1 == numberOfCities)
+        {
+            break;
+        }
 
-    routeLength += route.back()->getDistanceToPoint(points.at(startPointIndex));
-    route.push_back(&points.at(startPointIndex));
+        if (fragments.getDegree(edge.first) < 2 && fragments.getDegree(edge.second) < 2 && paths.unite(edge.first, edge.second))
+        {
+            fragments.addEdge(edge.first, edge.second);
+            ++numberOfEdges;
+        }
+    }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(timeStepMilliseconds)); 
+    joinPathFragments(visualization, isInterrupt, coordinates, fragments, route, routeLength);
 }
 
-void TravelingSalesmanAlgorithms::twoOptAlgorithm(const unsigned int& timeStepMilliseconds, const std::atomic<bool>& isInterrupt, 
-    std::vector<Point2D>& points, std::vector<Point2D*>& route, float& routeLength)
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::savingsAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength)
 {
-    if (!route.empty())
+    const uint32_t numberOfCities = coordinates.size();
+
+    route.reset(numberOfCities);
+    routeLength.reset(coordinates);
+
+    if (numberOfCities == 0)
+    {
+        return;
+    }
+
+    // The hub is the city closest to the center of mass, at first every other city is visited on a trip of its own
+    double centerX = 0.0;
+    double centerY = 0.0;
+    for (uint32_t city = 0; city < numberOfCities; ++city)
+    {
+        centerX += coordinates.getX(city);
+        centerY += coordinates.getY(city);
+    }
+    centerX /= numberOfCities;
+    centerY /= numberOfCities;
+
+    uint32_t hub = 0;
+    double hubSquaredDistance = std::numeric_limits<double>::max();
+    for (uint32_t city = 0; city < numberOfCities; ++city)
+    {
+        const double dx = coordinates.getX(city) - centerX;
+        const double dy = coordinates.getY(city) - centerY;
+        if (dx * dx + dy * dy < hubSquaredDistance)
+        {
+            hubSquaredDistance = dx * dx + dy * dy;
+            hub = city;
+        }
+    }
+
+    struct Saving
+    {
+        float saving;
+        uint32_t first;
+        uint32_t second;
+
+        bool operator<(const Saving& other) const { return saving < other.saving; }
+    };
+
+    // Joining the trips ending in first and second saves d(hub, first) + d(hub, second) - d(first, second)
+    std::vector<Saving> savings;
+    savings.reserve(candidateLists.getNeighborArray().size());
+    forEachCandidateEdge(candidateLists, [&](uint32_t first, uint32_t second)
+    {
+        if (first != hub && second != hub)
+        {
+            const float saving = coordinates.getDistance(hub, first) + coordinates.getDistance(hub, second) - coordinates.getDistance(first, second);
+            savings.push_back({ saving, first, second });
+        }
+    });
+    std::priority_queue<Saving> largestSavings(std::less<Saving>(), std::move(savings));
+
+    if (isInterrupt)
     {
-        route.clear();
+        return;
     }
-    if (route.capacity() < points.size() + 1)
+
+    PathFragments fragments;
+    fragments.reset(numberOfCities);
+    DisjointSets trips;
+    trips.reset(numberOfCities);
+
+    // Two trips are merged when both cities still end their trips, the trips without the hub form a path of numberOfCities - 2 edges
+    uint32_t numberOfEdges = 0;
+    while (!largestSavings.empty() && numberOfEdges + 2 < numberOfCities)
     {
-        route.reserve(points.size() + 1);
+        const Saving saving = largestSavings.top();
+        largestSavings.pop();
+
+        if (fragments.getDegree(saving.first) < 2 && fragments.getDegree(saving.second) < 2 && trips.unite(saving.first, saving.second))
+        {
+            fragments.addEdge(saving.first, saving.second);
+            ++numberOfEdges;
+        }
     }
 
-    routeLength = 0;
+    // Trips left unmerged by the candidate graph are joined like the greedy edge fragments, the hub being one of them
+    joinPathFragments(visualization, isInterrupt, coordinates, fragments, route, routeLength);
+}
+
+namespace
+{
+    struct TreeEdge
+    {
+        uint32_t first;
+        uint32_t second;
+    };
+
+    // Minimum spanning forest of the candidate graph by Kruskal, a spanning tree when the candidate graph is connected
+    std::vector<TreeEdge> findMinimumSpanningForest(const CityCoordinates& coordinates, const CandidateLists& candidateLists)
+    {
+        struct CandidateEdge
+        {
+            float squaredLength;
+            uint32_t first;
+            uint32_t second;
+        };
 
+        std::vector<CandidateEdge> edges;
+        edges.reserve(candidateLists.getNeighborArray().size());
+        forEachCandidateEdge(candidateLists, [&](uint32_t first, uint32_t second)
+        {
+            edges.push_back({ coordinates.getSquaredDistance(first, second), first, second });
+        });
+        std::sort(edges.begin(), edges.end(), [](const CandidateEdge& a, const CandidateEdge& b) { return a.squaredLength < b.squaredLength; });
 
-    randomRouteAlgorithm(timeStepMilliseconds, isInterrupt, points, route, routeLength);
+        const uint32_t numberOfCities = coordinates.size();
+        DisjointSets trees;
+        trees.reset(numberOfCities);
 
-    int numberOfPoints = points.size();
-    bool foundImprovement = true;
+        std::vector<TreeEdge> forest;
+        forest.reserve(numberOfCities);
+        for (const CandidateEdge& edge : edges)
+        {
+            if (forest.size() + 1 == numberOfCities)
+            {
+                break;
+            }
+            if (trees.unite(edge.first, edge.second))
+            {
+                forest.push_back({ edge.first, edge.second });
+            }
+        }
+        return forest;
+    }
 
-    while (foundImprovement)
+    // Greedy perfect matching of the given cities: repeatedly matches the closest pair of unmatched cities.
+    // Each unmatched city keeps its nearest unmatched city in a heap, found again with the kd-tree once that one got matched.
+    void appendGreedyMatching(const CityCoordinates& coordinates, const std::vector<uint32_t>& cities, std::vector<TreeEdge>& edges)
     {
-        foundImprovement = false;
-        for (int i = 0; i <= numberOfPoints - 2; ++i)
+        struct Pair
+        {
+            float squaredDistance;
+            uint32_t city;
+            uint32_t nearest;
+
+            bool operator>(const Pair& other) const { return squaredDistance > other.squaredDistance; }
+        };
+
+        KdTree unmatched;
+        unmatched.build(coordinates);
+        std::vector<uint8_t> isMatched(coordinates.size(), 1);
+        for (uint32_t city : cities)
+        {
+            isMatched[city] = 0;
+        }
+        for (uint32_t city = 0; city < coordinates.size(); ++city)
         {
-            for (int j = i + 2; j <= numberOfPoints - 1; ++j)
+            if (isMatched[city])
             {
-                if (isInterrupt)
+                unmatched.removeCity(city);
+            }
+        }
+
+        auto findNearestUnmatched = [&](uint32_t city)
+        {
+            unmatched.removeCity(city);
+            const uint32_t nearest = unmatched.findNearestRemaining(coordinates.getX(city), coordinates.getY(city));
+            unmatched.restoreCity(city);
+            return nearest;
+        };
+
+        std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> closestPairs;
+        for (uint32_t city : cities)
+        {
+            const uint32_t nearest = findNearestUnmatched(city);
+            if (nearest != KdTree::INVALID_CITY)
+            {
+                closestPairs.push({ coordinates.getSquaredDistance(city, nearest), city, nearest });
+            }
+        }
+
+        while (!closestPairs.empty())
+        {
+            const Pair pair = closestPairs.top();
+            closestPairs.pop();
+
+            if (isMatched[pair.city])
+            {
+                continue;
+            }
+            if (isMatched[pair.nearest])
+            {
+                const uint32_t nearest = findNearestUnmatched(pair.city);
+                if (nearest != KdTree::INVALID_CITY)
                 {
-                    return;
+                    closestPairs.push({ coordinates.getSquaredDistance(pair.city, nearest), pair.city, nearest });
                 }
+                continue;
+            }
+
+            isMatched[pair.city] = 1;
+            isMatched[pair.nearest] = 1;
+            unmatched.removeCity(pair.city);
+            unmatched.removeCity(pair.nearest);
+            edges.push_back({ pair.city, pair.nearest });
+        }
+    }
+
+    // Walks an Euler circuit through each connected part of a multigraph with only even degrees (Hierholzer)
+    // and adds the cities in the order of their first visit as a path to fragments, which shortcuts repeated visits
+    void addShortcutEulerCircuits(uint32_t numberOfCities, const std::vector<TreeEdge>& edges, PathFragments& fragments)
+    {
+        // Edges incident to each city in compressed rows
+        std::vector<uint32_t> offsets(numberOfCities + 1, 0);
+        for (const TreeEdge& edge : edges)
+        {
+            ++offsets[edge.first + 1];
+            ++offsets[edge.second + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
 
-                Point2D* firstEdge[2] = { route.at(i), route.at((i + 1) % numberOfPoints) };
-                Point2D* secondEdge[2] = { route.at(j), route.at((j + 1) % numberOfPoints) };
+        std::vector<uint32_t> incidentEdges(offsets.back());
+        std::vector<uint32_t> nextIncident(offsets.begin(), offsets.end() - 1);
+        for (uint32_t edge = 0; edge < edges.size(); ++edge)
+        {
+            incidentEdges[nextIncident[edges[edge].first]++] = edge;
+            incidentEdges[nextIncident[edges[edge].second]++] = edge;
+        }
+        std::copy(offsets.begin(), offsets.end() - 1, nextIncident.begin());
 
-                std::reverse(route.begin() + i + 1, route.begin() + j + 1);
+        std::vector<uint8_t> isEdgeUsed(edges.size(), 0);
+        std::vector<uint8_t> isVisited(numberOfCities, 0);
+        std::vector<uint32_t> stack;
 
-                firstEdge[0]->setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_B);
-                firstEdge[1]->setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_B);
-                std::this_thread::sleep_for(std::chrono::milliseconds(timeStepMilliseconds));
-                firstEdge[0]->setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_A);
-                firstEdge[1]->setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_A);
+        for (uint32_t start = 0; start < numberOfCities; ++start)
+        {
+            if (isVisited[start])
+            {
+                continue;
+            }
 
-                // Formula: https://en.wikipedia.org/wiki/2-opt
-                float routeLengthDelta = firstEdge[0]->getDistanceToPoint(*secondEdge[0]) + firstEdge[1]->getDistanceToPoint(*secondEdge[1]) 
-                    - firstEdge[0]->getDistanceToPoint(*firstEdge[1]) - secondEdge[0]->getDistanceToPoint(*secondEdge[1]);
+            uint32_t previous = NO_CITY;
+            stack.push_back(start);
+            while (!stack.empty())
+            {
+                const uint32_t city = stack.back();
+                uint32_t& incident = nextIncident[city];
+                while (incident < offsets[city + 1] && isEdgeUsed[incidentEdges[incident]])
+                {
+                    ++incident;
+                }
 
-                if ((int)routeLengthDelta >= 0)
+                if (incident < offsets[city + 1])
                 {
-                    std::reverse(route.begin() + i + 1, route.begin() + j + 1);
+                    const TreeEdge& edge = edges[incidentEdges[incident]];
+                    isEdgeUsed[incidentEdges[incident]] = 1;
+                    stack.push_back(edge.first == city ? edge.second : edge.first);
+                    continue;
                 }
-                else
+
+                // The circuit is completed backwards as cities run out of unused edges
+                stack.pop_back();
+                if (!isVisited[city])
                 {
-                    routeLength += routeLengthDelta;
-                    foundImprovement = true;
+                    isVisited[city] = 1;
+                    if (previous != NO_CITY)
+                    {
+                        fragments.addEdge(previous, city);
+                    }
+                    previous = city;
                 }
             }
         }
     }
 }
 
-void TravelingSalesmanAlgorithms::randomRouteAlgorithm(const unsigned int& timeStepMilliseconds, const std::atomic<bool>& isInterrupt, 
-    std::vector<Point2D>& points, std::vector<Point2D*>& route, float& routeLength)
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::spanningTreeAlgorithm(SolvingAlgorithm variant, Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength)
 {
-    if (!route.empty())
+    const uint32_t numberOfCities = coordinates.size();
+
+    route.reset(numberOfCities);
+    routeLength.reset(coordinates);
+
+    if (numberOfCities == 0)
     {
-        route.clear();
+        return;
     }
-    if (route.capacity() < points.size() + 1)
+
+    std::vector<TreeEdge> eulerianEdges = findMinimumSpanningForest(coordinates, candidateLists);
+
+    if (isInterrupt)
     {
-        route.reserve(points.size() + 1);
+        return;
     }
 
-    routeLength = 0;
-
+    // Doubling every tree edge or matching the odd degree cities makes all degrees even
+    if (variant == DOUBLE_TREE)
+    {
+        eulerianEdges.insert(eulerianEdges.end(), eulerianEdges.begin(), eulerianEdges.end());
+    }
+    else
+    {
+        std::vector<uint32_t> degrees(numberOfCities, 0);
+        for (const TreeEdge& edge : eulerianEdges)
+        {
+            ++degrees[edge.first];
+            ++degrees[edge.second];
+        }
 
-    const int startPointIndex = 0;
+        std::vector<uint32_t> oddCities;
+        for (uint32_t city = 0; city < numberOfCities; ++city)
+        {
+            if (degrees[city] % 2 == 1)
+            {
+                oddCities.push_back(city);
+            }
+        }
+        appendGreedyMatching(coordinates, oddCities, eulerianEdges);
+    }
 
-    int numberOfPoints = points.size();
-    std::vector<bool> isVisited(numberOfPoints, false);
+    if (isInterrupt)
+    {
+        return;
+    }
 
-    isVisited.at(startPointIndex) = true;
-    route.push_back(&points.at(startPointIndex));
+    // Parts left unconnected by the candidate graph end up as separate paths, joined like the greedy edge fragments
+    PathFragments fragments;
+    fragments.reset(numberOfCities);
+    addShortcutEulerCircuits(numberOfCities, eulerianEdges, fragments);
 
-    points.at(startPointIndex).setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_A);
+    joinPathFragments(visualization, isInterrupt, coordinates, fragments, route, routeLength);
+}
 
-    std::random_device rd;
-    std::uniform_int_distribution<int> pointDistribution(0, numberOfPoints - 1);
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::spaceFillingCurveAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, Route& route, RouteLength& routeLength)
+{
+    route.reset(coordinates.size());
+    routeLength.reset(coordinates);
 
-    while (route.size() < numberOfPoints)
+    for (uint32_t city : SpaceFillingCurve::getHilbertOrder(coordinates))
     {
         if (isInterrupt)
         {
             return;
         }
 
-        int randomPointIndex = pointDistribution(rd);
-
-        if (isVisited.at(randomPointIndex))
+        if (!route.isEmpty())
         {
-            continue;
+            routeLength.add(coordinates.getDistance(route.at(route.size() - 1), city));
         }
-        route.push_back(&points.at(randomPointIndex));
+        route.append(city);
 
-        points.at(randomPointIndex).setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_A);
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeStepMilliseconds));
-        
-        isVisited.at(randomPointIndex) = true;
+        visualization.setOutgoingLineColor(city, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+        visualization.waitTimeStep();
     }
 
-    route.push_back(&points.at(0));
-    points.at(0).setOutgoingLineColor(SolverColors::LINE_HIGHLIGHT_COLOR_A);
+    if (!route.isEmpty())
+    {
+        routeLength.add(coordinates.getDistance(route.at(route.size() - 1), route.at(0)));
+    }
+}
+
+namespace
+{
+    // Partial tour of an insertion construction as a singly linked cycle, a single city links to itself
+    class InsertionTour
+    {
+        std::vector<uint32_t> m_next;
+        uint32_t m_start = NO_CITY;
+        uint32_t m_size = 0;
+
+    public:
+        void reset(uint32_t numberOfCities, uint32_t start)
+        {
+            m_next.assign(numberOfCities, NO_CITY);
+            m_next[start] = start;
+            m_start = start;
+            m_size = 1;
+        };
+
+        uint32_t size() const { return m_size; };
+        uint32_t getStart() const { return m_start; };
+        bool contains(uint32_t city) const { return m_next[city] != NO_CITY; };
+        uint32_t next(uint32_t city) const { return m_next[city]; };
+
+        void insertAfter(uint32_t city, uint32_t inserted)
+        {
+            m_next[inserted] = m_next[city];
+            m_next[city] = inserted;
+            ++m_size;
+        };
+
+        // Added length of inserting city into the edge leaving edgeStart
+        double getInsertionCost(const CityCoordinates& coordinates, uint32_t edgeStart, uint32_t city) const
+        {
+            const uint32_t edgeEnd = m_next[edgeStart];
+            return static_cast<double>(coordinates.getDistance(edgeStart, city)) + coordinates.getDistance(city, edgeEnd)
+                - coordinates.getDistance(edgeStart, edgeEnd);
+        };
+
+        // Start of the tour edge where inserting city adds the least length, together with that length
+        uint32_t findCheapestEdge(const CityCoordinates& coordinates, uint32_t city, double& cost) const
+        {
+            uint32_t cheapestEdgeStart = m_start;
+            cost = std::numeric_limits<double>::infinity();
+
+            uint32_t edgeStart = m_start;
+            do
+            {
+                const double edgeCost = getInsertionCost(coordinates, edgeStart, city);
+                if (edgeCost < cost)
+                {
+                    cost = edgeCost;
+                    cheapestEdgeStart = edgeStart;
+                }
+                edgeStart = m_next[edgeStart];
+            } while (edgeStart != m_start);
+
+            return cheapestEdgeStart;
+        };
+
+        void writeTo(Route& route) const
+        {
+            route.reset(m_next.size());
+            uint32_t city = m_start;
+            do
+            {
+                route.append(city);
+                city = m_next[city];
+            } while (city != m_start);
+        };
+    };
+
+    // Counter-clockwise convex hull (Andrew's monotone chain), collinear boundary cities are left for insertion
+    std::vector<uint32_t> findConvexHull(const CityCoordinates& coordinates)
+    {
+        std::vector<uint32_t> cities(coordinates.size());
+        std::iota(cities.begin(), cities.end(), 0);
+        std::sort(cities.begin(), cities.end(), [&coordinates](uint32_t a, uint32_t b)
+            {
+                return coordinates.getX(a) < coordinates.getX(b) || (coordinates.getX(a) == coordinates.getX(b) && coordinates.getY(a) < coordinates.getY(b));
+            });
+
+        if (cities.size() < 3)
+        {
+            return cities;
+        }
+
+        auto cross = [&coordinates](uint32_t origin, uint32_t a, uint32_t b)
+        {
+            return (static_cast<double>(coordinates.getX(a)) - coordinates.getX(origin)) * (static_cast<double>(coordinates.getY(b)) - coordinates.getY(origin))
+                - (static_cast<double>(coordinates.getY(a)) - coordinates.getY(origin)) * (static_cast<double>(coordinates.getX(b)) - coordinates.getX(origin));
+        };
+
+        std::vector<uint32_t> hull(2 * cities.size());
+        size_t hullSize = 0;
+        // Lower hull left to right, then upper hull right to left
+        for (size_t i = 0; i < cities.size(); ++i)
+        {
+            while (hullSize >= 2 && cross(hull[hullSize - 2], hull[hullSize - 1], cities[i]) <= 0.0)
+            {
+                --hullSize;
+            }
+            hull[hullSize++] = cities[i];
+        }
+        for (size_t i = cities.size() - 1, lowerSize = hullSize + 1; i-- > 0;)
+        {
+            while (hullSize >= lowerSize && cross(hull[hullSize - 2], hull[hullSize - 1], cities[i]) <= 0.0)
+            {
+                --hullSize;
+            }
+            hull[hullSize++] = cities[i];
+        }
 
+        // The first city closes the upper hull again
+        hull.resize(hullSize - 1);
+        return hull;
+    }
 }
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::insertionAlgorithm(SolvingAlgorithm insertion, Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, Route& route, RouteLength& routeLength)
+{
+    const uint32_t numberOfCities = coordinates.size();
+
+    route.reset(numberOfCities);
+    routeLength.reset(coordinates);
+
+    if (numberOfCities == 0)
+    {
+        return;
+    }
+
+    InsertionTour tour;
+    if (insertion == CONVEX_HULL_INSERTION)
+    {
+        const std::vector<uint32_t> hull = findConvexHull(coordinates);
+        tour.reset(numberOfCities, hull[0]);
+        for (size_t i = 1; i < hull.size(); ++i)
+        {
+            tour.insertAfter(hull[i - 1], hull[i]);
+        }
+    }
+    else
+    {
+        tour.reset(numberOfCities, 0);
+    }
+
+    // Cities not in the tour yet, removed by swapping in the last one
+    std::vector<uint32_t> remaining;
+    remaining.reserve(numberOfCities);
+    for (uint32_t city = 0; city < numberOfCities; ++city)
+    {
+        if (!tour.contains(city))
+        {
+            remaining.push_back(city);
+        }
+    }
+
+    // Per remaining city: for the cheapest insertions the start of its cheapest tour edge and the cost there,
+    // for nearest and farthest insertion its squared distance to the closest tour city.
+    // When the cheapest edge of a city is split and both new edges cost more, the old cost stays as a lower bound
+    // for all its edges and the edge is marked unknown (NO_CITY). It is only searched again once the city gets selected.
+    const bool isCheapestFirst = insertion == CHEAPEST_INSERTION || insertion == CONVEX_HULL_INSERTION;
+    std::vector<uint32_t> cheapestEdges(numberOfCities, NO_CITY);
+    std::vector<double> keys(numberOfCities);
+    for (uint32_t city : remaining)
+    {
+        if (isCheapestFirst)
+        {
+            cheapestEdges[city] = tour.findCheapestEdge(coordinates, city, keys[city]);
+        }
+        else
+        {
+            keys[city] = coordinates.getSquaredDistance(city, tour.getStart());
+        }
+    }
+
+    while (!remaining.empty())
+    {
+        if (isInterrupt)
+        {
+            return;
+        }
+
+        // The farthest city has the largest key, all other rules pick the smallest
+        size_t selectedIndex;
+        while (true)
+        {
+            selectedIndex = 0;
+            for (size_t i = 1; i < remaining.size(); ++i)
+            {
+                const double key = keys[remaining[i]];
+                const double selectedKey = keys[remaining[selectedIndex]];
+                if (insertion == FARTHEST_INSERTION ? key > selectedKey : key < selectedKey)
+                {
+                    selectedIndex = i;
+                }
+            }
+
+            const uint32_t selected = remaining[selectedIndex];
+            if (!isCheapestFirst || cheapestEdges[selected] != NO_CITY)
+            {
+                break;
+            }
+            cheapestEdges[selected] = tour.findCheapestEdge(coordinates, selected, keys[selected]);
+        }
+        const uint32_t city = remaining[selectedIndex];
+        remaining[selectedIndex] = remaining.back();
+        remaining.pop_back();
+
+        double cost;
+        const uint32_t edgeStart = isCheapestFirst ? cheapestEdges[city] : tour.findCheapestEdge(coordinates, city, cost);
+        tour.insertAfter(edgeStart, city);
+
+        // Only the two new edges and the distance to the new city have to be looked at
+        for (uint32_t other : remaining)
+        {
+            if (!isCheapestFirst)
+            {
+                keys[other] = std::min<double>(keys[other], coordinates.getSquaredDistance(other, city));
+                continue;
+            }
+
+            const double costBefore = tour.getInsertionCost(coordinates, edgeStart, other);
+            const double costAfter = tour.getInsertionCost(coordinates, city, other);
+            const double newEdgeCost = std::min(costBefore, costAfter);
+            const bool isCheapestEdgeSplit = cheapestEdges[other] == edgeStart;
+
+            // Every other edge costs at least the current key, so a new edge at or below it is the cheapest
+            if (newEdgeCost < keys[other] || (isCheapestEdgeSplit && newEdgeCost == keys[other]))
+            {
+                keys[other] = newEdgeCost;
+                cheapestEdges[other] = costBefore <= costAfter ? edgeStart : city;
+            }
+            else if (isCheapestEdgeSplit)
+            {
+                cheapestEdges[other] = NO_CITY;
+            }
+        }
+
+        if constexpr (Visualization::IS_ANIMATED)
+        {
+            tour.writeTo(route);
+            visualization.setOutgoingLineColor(edgeStart, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+            visualization.setOutgoingLineColor(city, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+            visualization.waitTimeStep();
+        }
+    }
+
+    tour.writeTo(route);
+    routeLength.recompute(coordinates, route);
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::twoOptAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt, 
+    const CityCoordinates& coordinates, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        randomRouteAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+    }
+
+    const uint32_t numberOfPoints = coordinates.size();
+    if (numberOfPoints < 4)
+    {
+        return;
+    }
+
+    // All second edges of a first edge are scanned at once by the SIMD kernel over coordinates gathered in tour order
+    TwoOptKernel kernel;
+    kernel.gather(coordinates, route);
+
+    // Only cities whose outgoing edge may take part in an improving move are examined,
+    // an applied move wakes up the endpoints of the four edges it touched
+    ActiveCityQueue activeCities;
+    activeCities.reset(numberOfPoints);
+
+    while (!activeCities.isEmpty())
+    {
+        if (isInterrupt)
+        {
+            return;
+        }
+
+        const uint32_t i = route.getPosition(activeCities.pop());
+
+        visualization.setOutgoingLineColor(route.at(i), SolverColors::LINE_HIGHLIGHT_COLOR_B);
+        visualization.waitTimeStep();
+        visualization.setOutgoingLineColor(route.at(i), SolverColors::LINE_HIGHLIGHT_COLOR_A);
+
+        // Second edges sharing no city with the first one: the ones after it, then the ones before it
+        TwoOptKernel::Move bestMove = kernel.findBestMove(i, i + 2, i == 0 ? numberOfPoints - 1 : numberOfPoints);
+        if (i >= 2)
+        {
+            const TwoOptKernel::Move move = kernel.findBestMove(i, i == numberOfPoints - 1 ? 1 : 0, i - 1);
+            if (move.delta < bestMove.delta)
+            {
+                bestMove = move;
+            }
+        }
+
+        if (!(bestMove.delta < 0.0f))
+        {
+            continue;
+        }
+
+        const uint32_t first = std::min(i, bestMove.secondPosition);
+        const uint32_t second = std::max(i, bestMove.secondPosition);
+
+        const uint32_t firstEdge[2] = { route.at(first), route.at(first + 1) };
+        const uint32_t secondEdge[2] = { route.at(second), route.at((second + 1) % numberOfPoints) };
+
+        // Formula: https://en.wikipedia.org/wiki/2-opt
+        // The kernel works in float, the move is checked again with the exact distances before it is applied.
+        // Summed in double and compared against zero, so improvements smaller than one unit are accepted too
+        const double routeLengthDelta = static_cast<double>(coordinates.getDistance(firstEdge[0], secondEdge[0])) + coordinates.getDistance(firstEdge[1], secondEdge[1])
+            - coordinates.getDistance(firstEdge[0], firstEdge[1]) - coordinates.getDistance(secondEdge[0], secondEdge[1]);
+
+        if (routeLengthDelta < 0.0)
+        {
+            route.reverseCyclic(first + 1, second);
+            routeLength.add(routeLengthDelta);
+            routeLength.resynchronize(coordinates, route);
+
+            // Either the segment or its complement was reversed, whichever was shorter
+            if (route.at(first + 1) == secondEdge[0])
+            {
+                kernel.update(coordinates, route, first + 1, second);
+            }
+            else
+            {
+                kernel.update(coordinates, route, (second + 1) % numberOfPoints, first);
+            }
+
+            activeCities.push(firstEdge[0]);
+            activeCities.push(firstEdge[1]);
+            activeCities.push(secondEdge[0]);
+            activeCities.push(secondEdge[1]);
+        }
+    }
+}
+
+namespace
+{
+    // Runs improve, a local search written against the tour queries shared by Route and TwoLevelTour, on a two-level
+    // copy of route when the route is long enough for O(sqrt(n)) flips to beat array reversals
+    template <typename Improve>
+    void improveOnFastestTour(Route& route, Improve&& improve)
+    {
+        if (route.getNumberOfCities() >= TwoLevelTour::MIN_NUMBER_OF_CITIES)
+        {
+            TwoLevelTour tour;
+            tour.build(route);
+            improve(tour);
+            tour.writeTo(route);
+        }
+        else
+        {
+            improve(route);
+        }
+    }
+
+    // Tries the 2-opt moves adding an edge from city to one of its candidates, in both tour directions,
+    // and applies the first improving one. Candidates are sorted by distance, so the scan stops as soon as
+    // the new edge is not shorter than the tour edge it would replace.
+    template <typename Visualization, typename Tour>
+    bool applyTwoOptNeighborMove(Visualization& visualization, const CityCoordinates& coordinates, const CandidateLists& candidateLists,
+        Tour& tour, ActiveCityQueue& activeCities, uint32_t city, RouteLength& routeLength)
+    {
+        for (int direction = 0; direction < 2; ++direction)
+        {
+            const bool isForward = direction == 0;
+            const uint32_t tourNeighbor = isForward ? tour.next(city) : tour.prev(city);
+            const float removedDistance = coordinates.getDistance(city, tourNeighbor);
+
+            for (uint32_t candidate : candidateLists.getNeighbors(city))
+            {
+                const float addedDistance = coordinates.getDistance(city, candidate);
+                if (addedDistance >= removedDistance)
+                {
+                    break;
+                }
+
+                const uint32_t candidateTourNeighbor = isForward ? tour.next(candidate) : tour.prev(candidate);
+                if (candidate == tourNeighbor || candidateTourNeighbor == city)
+                {
+                    continue;
+                }
+
+                const double routeLengthDelta = static_cast<double>(addedDistance) + coordinates.getDistance(tourNeighbor, candidateTourNeighbor)
+                    - removedDistance - coordinates.getDistance(candidate, candidateTourNeighbor);
+                if (routeLengthDelta >= 0.0)
+                {
+                    continue;
+                }
+
+                // Forward: city tourNeighbor ... candidate candidateTourNeighbor, reversing tourNeighbor..candidate
+                // Backward: candidateTourNeighbor candidate ... tourNeighbor city, reversing candidate..tourNeighbor
+                if (isForward)
+                {
+                    tour.flip(tourNeighbor, candidate);
+                }
+                else
+                {
+                    tour.flip(candidate, tourNeighbor);
+                }
+                routeLength.add(routeLengthDelta);
+                routeLength.resynchronize(coordinates, tour);
+
+                activeCities.push(city);
+                activeCities.push(tourNeighbor);
+                activeCities.push(candidate);
+                activeCities.push(candidateTourNeighbor);
+
+                visualization.setOutgoingLineColor(city, SolverColors::LINE_HIGHLIGHT_COLOR_B);
+                visualization.setOutgoingLineColor(candidate, SolverColors::LINE_HIGHLIGHT_COLOR_B);
+                visualization.waitTimeStep();
+                visualization.setOutgoingLineColor(city, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+                visualization.setOutgoingLineColor(candidate, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::twoOptNeighborListAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        randomRouteAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+    }
+
+    improveOnFastestTour(route, [&](auto& tour)
+    {
+        ActiveCityQueue activeCities;
+        activeCities.reset(coordinates.size());
+
+        while (!activeCities.isEmpty())
+        {
+            if (isInterrupt)
+            {
+                return;
+            }
+
+            applyTwoOptNeighborMove(visualization, coordinates, candidateLists, tour, activeCities, activeCities.pop(), routeLength);
+        }
+    });
+}
+
+namespace
+{
+    // Tries to move a segment of 1 to MAX_MOVED_SEGMENT_LENGTH cities having city at one of its ends, placing one
+    // segment endpoint next to one of its candidates, and applies the first improving move. The scan over the sorted
+    // candidates stops once the new edge alone is not shorter than what removing the segment saves.
+    template <typename Visualization>
+    bool applyOrOptMove(Visualization& visualization, const CityCoordinates& coordinates, const CandidateLists& candidateLists,
+        Route& route, ActiveCityQueue& activeCities, uint32_t city, RouteLength& routeLength)
+    {
+        const uint32_t numberOfCities = route.getNumberOfCities();
+
+        for (uint32_t segmentLength = 1; segmentLength <= Route::MAX_MOVED_SEGMENT_LENGTH; ++segmentLength)
+        {
+            for (int direction = 0; direction < 2; ++direction)
+            {
+                // A single city segment is the same in both directions
+                if (segmentLength == 1 && direction == 1)
+                {
+                    continue;
+                }
+
+                // The segment either starts or ends with city
+                const uint32_t cityPosition = route.getPosition(city);
+                const uint32_t segmentFirstPosition = direction == 0 ? cityPosition : (cityPosition + numberOfCities - segmentLength + 1) % numberOfCities;
+                const uint32_t segmentFirst = route.at(segmentFirstPosition);
+                const uint32_t segmentLast = route.at((segmentFirstPosition + segmentLength - 1) % numberOfCities);
+                const uint32_t segmentPrev = route.prev(segmentFirst);
+                const uint32_t segmentNext = route.next(segmentLast);
+
+                const double removalGain = static_cast<double>(coordinates.getDistance(segmentPrev, segmentFirst)) + coordinates.getDistance(segmentLast, segmentNext)
+                    - coordinates.getDistance(segmentPrev, segmentNext);
+                if (removalGain <= 0.0)
+                {
+                    continue;
+                }
+
+                auto isInSegment = [&](uint32_t other)
+                {
+                    return (route.getPosition(other) + numberOfCities - segmentFirstPosition) % numberOfCities < segmentLength;
+                };
+
+                for (int end = 0; end < 2; ++end)
+                {
+                    const uint32_t endpoint = end == 0 ? segmentFirst : segmentLast;
+                    const uint32_t otherEndpoint = end == 0 ? segmentLast : segmentFirst;
+
+                    for (uint32_t candidate : candidateLists.getNeighbors(endpoint))
+                    {
+                        const float addedDistance = coordinates.getDistance(endpoint, candidate);
+                        if (addedDistance >= removalGain)
+                        {
+                            break;
+                        }
+
+                        if (isInSegment(candidate))
+                        {
+                            continue;
+                        }
+
+                        // Insert between candidate and either of its tour neighbors, endpoint being the one next to candidate
+                        for (int side = 0; side < 2; ++side)
+                        {
+                            const bool isAfterCandidate = side == 0;
+                            const uint32_t candidateTourNeighbor = isAfterCandidate ? route.next(candidate) : route.prev(candidate);
+                            if (isInSegment(candidateTourNeighbor))
+                            {
+                                continue;
+                            }
+
+                            const double routeLengthDelta = static_cast<double>(addedDistance) + coordinates.getDistance(otherEndpoint, candidateTourNeighbor)
+                                - coordinates.getDistance(candidate, candidateTourNeighbor) - removalGain;
+                            if (routeLengthDelta >= 0.0)
+                            {
+                                continue;
+                            }
+
+                            // After candidate the segment has to start with endpoint, before candidate it has to end with it
+                            const uint32_t targetCity = isAfterCandidate ? candidate : candidateTourNeighbor;
+                            const bool isReversed = isAfterCandidate ? endpoint != segmentFirst : endpoint == segmentFirst;
+                            route.moveSegment(segmentFirstPosition, segmentLength, targetCity, isReversed);
+                            routeLength.add(routeLengthDelta);
+                            routeLength.resynchronize(coordinates, route);
+
+                            activeCities.push(segmentPrev);
+                            activeCities.push(segmentNext);
+                            activeCities.push(segmentFirst);
+                            activeCities.push(segmentLast);
+                            activeCities.push(candidate);
+                            activeCities.push(candidateTourNeighbor);
+
+                            visualization.setOutgoingLineColor(segmentPrev, SolverColors::LINE_HIGHLIGHT_COLOR_B);
+                            visualization.setOutgoingLineColor(targetCity, SolverColors::LINE_HIGHLIGHT_COLOR_B);
+                            visualization.waitTimeStep();
+                            visualization.setOutgoingLineColor(segmentPrev, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+                            visualization.setOutgoingLineColor(targetCity, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::orOptAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        randomRouteAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+    }
+
+    // The segment, its two tour neighbors and the two cities it is placed between have to be distinct
+    if (route.getNumberOfCities() < Route::MAX_MOVED_SEGMENT_LENGTH + 3)
+    {
+        return;
+    }
+
+    ActiveCityQueue activeCities;
+    activeCities.reset(coordinates.size());
+
+    while (!activeCities.isEmpty())
+    {
+        if (isInterrupt)
+        {
+            return;
+        }
+
+        applyOrOptMove(visualization, coordinates, candidateLists, route, activeCities, activeCities.pop(), routeLength);
+    }
+}
+
+namespace
+{
+    // Variable-depth search from a base city t1. Removing the tour edge (t1, t2) leaves a path whose free end t2 is joined
+    // to a candidate t3; the tour neighbor t4 of t3 that keeps a Hamiltonian cycle is cut loose and becomes the new free end.
+    // Every step is carried out as a 2-opt flip, so the tour is always valid and the closed gain is known after each step.
+    // The first sequence with a positive closed gain is kept, otherwise all flips are undone.
+    template <typename Visualization, typename Tour>
+    class LinKernighanSearch
+    {
+        // Alternatives tried at the first levels of the search, deeper levels only follow the best one
+        static constexpr uint32_t MAX_BREADTH = 5;
+        static constexpr uint32_t BREADTH[] = { MAX_BREADTH, 3, 2 };
+        static constexpr uint32_t MAX_DEPTH = 50;
+
+        struct Edge
+        {
+            uint32_t from;
+            uint32_t to;
+
+            bool matches(uint32_t a, uint32_t b) const { return (from == a && to == b) || (from == b && to == a); };
+        };
+
+        struct Step
+        {
+            uint32_t t3;
+            uint32_t t4;
+            double score;
+        };
+
+        Visualization& m_visualization;
+        const CityCoordinates& m_coordinates;
+        const CandidateLists& m_candidateLists;
+        Tour& m_tour;
+        RouteLength& m_tourLength;
+
+        // An edge added by the current sequence is never removed again and a removed one is never added back
+        std::vector<Edge> m_addedEdges;
+        std::vector<Edge> m_removedEdges;
+        std::vector<uint32_t> m_touchedCities;
+
+    public:
+        LinKernighanSearch(Visualization& visualization, const CityCoordinates& coordinates, const CandidateLists& candidateLists,
+            Tour& tour, RouteLength& routeLength) :
+            m_visualization(visualization), m_coordinates(coordinates), m_candidateLists(candidateLists), m_tour(tour), m_tourLength(routeLength)
+        {
+            m_addedEdges.reserve(MAX_DEPTH);
+            m_removedEdges.reserve(MAX_DEPTH + 1);
+            m_touchedCities.reserve(2 * MAX_DEPTH + 2);
+        }
+
+        // Returns true and wakes up every city touched by the move if an improving move starting at t1 was applied
+        bool improve(uint32_t t1, ActiveCityQueue& activeCities)
+        {
+            for (int direction = 0; direction < 2; ++direction)
+            {
+                const uint32_t t2 = direction == 0 ? m_tour.next(t1) : m_tour.prev(t1);
+
+                m_addedEdges.clear();
+                m_removedEdges.clear();
+                m_touchedCities.clear();
+                m_removedEdges.push_back({ t1, t2 });
+                m_touchedCities.push_back(t1);
+                m_touchedCities.push_back(t2);
+
+                if (search(t1, t2, m_coordinates.getDistance(t1, t2), 0))
+                {
+                    for (uint32_t city : m_touchedCities)
+                    {
+                        activeCities.push(city);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        bool isAdded(uint32_t a, uint32_t b) const
+        {
+            return std::any_of(m_addedEdges.begin(), m_addedEdges.end(), [a, b](const Edge& edge) { return edge.matches(a, b); });
+        }
+
+        bool isRemoved(uint32_t a, uint32_t b) const
+        {
+            return std::any_of(m_removedEdges.begin(), m_removedEdges.end(), [a, b](const Edge& edge) { return edge.matches(a, b); });
+        }
+
+        // Replaces the edges (t1, t2) and (t3, t4) with (t2, t3) and (t4, t1), t2 and t4 lying on the same side of t1 and t3
+        void applyMove(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4)
+        {
+            const double routeLengthDelta = static_cast<double>(m_coordinates.getDistance(t2, t3)) + m_coordinates.getDistance(t4, t1)
+                - m_coordinates.getDistance(t1, t2) - m_coordinates.getDistance(t3, t4);
+
+            if (m_tour.next(t1) == t2)
+            {
+                m_tour.flip(t2, t4);
+            }
+            else
+            {
+                m_tour.flip(t4, t2);
+            }
+            m_tourLength.add(routeLengthDelta);
+        }
+
+        // gain is the length of the removed edges minus the added ones, not counting the edge (t2, t1) closing the tour
+        bool search(uint32_t t1, uint32_t t2, double gain, uint32_t depth)
+        {
+            const bool isForward = m_tour.next(t1) == t2;
+            const uint32_t breadth = depth < std::size(BREADTH) ? BREADTH[depth] : 1;
+
+            Step steps[MAX_BREADTH];
+            uint32_t numberOfSteps = 0;
+
+            for (uint32_t t3 : m_candidateLists.getNeighbors(t2))
+            {
+                const double openGain = gain - m_coordinates.getDistance(t2, t3);
+                if (openGain <= 0.0)
+                {
+                    break;
+                }
+
+                const uint32_t t4 = isForward ? m_tour.prev(t3) : m_tour.next(t3);
+                // t4 == t2 when t3 already follows t2 on the path
+                if (t3 == t1 || t4 == t2 || isAdded(t3, t4) || isRemoved(t2, t3))
+                {
+                    continue;
+                }
+
+                // Prefer the steps that leave the largest gain once (t3, t4) is removed
+                const Step step = { t3, t4, m_coordinates.getDistance(t3, t4) - m_coordinates.getDistance(t2, t3) };
+                uint32_t index = numberOfSteps < breadth ? numberOfSteps++ : breadth;
+                while (index > 0 && steps[index - 1].score < step.score)
+                {
+                    if (index < breadth)
+                    {
+                        steps[index] = steps[index - 1];
+                    }
+                    --index;
+                }
+                if (index < breadth)
+                {
+                    steps[index] = step;
+                }
+            }
+
+            for (uint32_t i = 0; i < numberOfSteps; ++i)
+            {
+                const uint32_t t3 = steps[i].t3;
+                const uint32_t t4 = steps[i].t4;
+                const double nextGain = gain - m_coordinates.getDistance(t2, t3) + m_coordinates.getDistance(t3, t4);
+
+                applyMove(t1, t2, t3, t4);
+                m_addedEdges.push_back({ t2, t3 });
+                m_removedEdges.push_back({ t3, t4 });
+                m_touchedCities.push_back(t3);
+                m_touchedCities.push_back(t4);
+
+                m_visualization.setOutgoingLineColor(t2, SolverColors::LINE_HIGHLIGHT_COLOR_B);
+                m_visualization.setOutgoingLineColor(t3, SolverColors::LINE_HIGHLIGHT_COLOR_B);
+                m_visualization.waitTimeStep();
+                m_visualization.setOutgoingLineColor(t2, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+                m_visualization.setOutgoingLineColor(t3, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+
+                if (nextGain - m_coordinates.getDistance(t4, t1) > 0.0)
+                {
+                    m_tourLength.resynchronize(m_coordinates, m_tour);
+                    return true;
+                }
+
+                if (depth + 1 < MAX_DEPTH && search(t1, t4, nextGain, depth + 1))
+                {
+                    return true;
+                }
+
+                // Undo by moving the edges back: (t1, t4) and (t3, t2) out, (t4, t3) and (t2, t1) in
+                applyMove(t1, t4, t3, t2);
+                m_addedEdges.pop_back();
+                m_removedEdges.pop_back();
+                m_touchedCities.resize(m_touchedCities.size() - 2);
+            }
+
+            return false;
+        }
+    };
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::linKernighanAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        randomRouteAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+    }
+
+    if (route.getNumberOfCities() < 4)
+    {
+        return;
+    }
+
+    improveOnFastestTour(route, [&](auto& tour)
+    {
+        LinKernighanSearch<Visualization, std::remove_reference_t<decltype(tour)>> search(visualization, coordinates, candidateLists, tour, routeLength);
+
+        ActiveCityQueue activeCities;
+        activeCities.reset(coordinates.size());
+
+        while (!activeCities.isEmpty())
+        {
+            if (isInterrupt)
+            {
+                return;
+            }
+
+            search.improve(activeCities.pop(), activeCities);
+        }
+    });
+}
+
+namespace
+{
+    // Start tour of the randomized metaheuristics when none is given. Unlike randomRouteAlgorithm it draws from the run's
+    // seed, so such runs repeat as well.
+    void seededRandomRoute(const CityCoordinates& coordinates, uint64_t seed, Route& route, RouteLength& routeLength)
+    {
+        std::vector<uint32_t> cities(coordinates.size());
+        std::iota(cities.begin(), cities.end(), 0);
+
+        FastRandom random(seed);
+        for (uint32_t i = cities.size(); i > 1; --i)
+        {
+            std::swap(cities[i - 1], cities[random.nextBelow(i)]);
+        }
+
+        route.reset(coordinates.size());
+        for (const uint32_t city : cities)
+        {
+            route.append(city);
+        }
+
+        routeLength.recompute(coordinates, route);
+    }
+
+    // Metropolis acceptance with exp(-x) read from a table instead of computed per move. Uphill moves costing more than
+    // MAX_EXPONENT temperatures have a probability below 1e-8 and are rejected outright.
+    class MetropolisCriterion
+    {
+        static constexpr uint32_t TABLE_SIZE = 4096;
+        static constexpr double MAX_EXPONENT = 20.0;
+
+        float m_probabilities[TABLE_SIZE];
+
+    public:
+        MetropolisCriterion()
+        {
+            for (uint32_t i = 0; i < TABLE_SIZE; ++i)
+            {
+                m_probabilities[i] = static_cast<float>(std::exp(-(i + 0.5) * MAX_EXPONENT / TABLE_SIZE));
+            }
+        };
+
+        bool isAccepted(double routeLengthDelta, double inverseTemperature, FastRandom& random) const
+        {
+            if (routeLengthDelta <= 0.0)
+            {
+                return true;
+            }
+            const double exponent = routeLengthDelta * inverseTemperature;
+            if (exponent >= MAX_EXPONENT)
+            {
+                return false;
+            }
+            return random.nextFloat() < m_probabilities[static_cast<uint32_t>(exponent * (TABLE_SIZE / MAX_EXPONENT))];
+        };
+    };
+
+    // The start and end temperature from the settings, the defaults scale with the distance between neighboring cities,
+    // which unlike the tour length does not depend on how good the start tour is
+    void getAnnealingTemperatures(const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings,
+        double& startTemperature, double& endTemperature)
+    {
+        startTemperature = settings.annealingStartTemperature;
+        if (startTemperature <= 0.0)
+        {
+            double nearestDistanceSum = 0.0;
+            for (uint32_t city = 0; city < coordinates.size(); ++city)
+            {
+                const std::span<const uint32_t> candidates = candidateLists.getNeighbors(city);
+                nearestDistanceSum += candidates.empty() ? 0.0 : coordinates.getDistance(city, candidates[0]);
+            }
+            startTemperature = std::max(TravelingSalesmanAlgorithms::ANNEALING_START_TEMPERATURE_FACTOR * nearestDistanceSum / coordinates.size(),
+                std::numeric_limits<double>::min());
+        }
+        endTemperature = settings.annealingEndTemperature > 0.0 ? settings.annealingEndTemperature
+            : startTemperature * TravelingSalesmanAlgorithms::ANNEALING_END_TEMPERATURE_RATIO;
+    }
+
+    // Replaces the tour edges (a, b) and (c, d) with (a, c) and (b, d), b following a and d following c in the same direction
+    template <typename Tour>
+    void applyTwoOptMove(Tour& tour, uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+    {
+        if (tour.next(a) == b)
+        {
+            tour.flip(b, c);
+        }
+        else
+        {
+            tour.flip(a, d);
+        }
+    }
+
+    // Random 2-opt and Or-opt moves between a city and one of its candidates, evaluated from the endpoints of the
+    // changed edges in O(1). Only accepted moves touch the tour, as one to three flips.
+    template <typename Tour>
+    class AnnealingMoves
+    {
+        const CityCoordinates& m_coordinates;
+        const CandidateLists& m_candidateLists;
+        Tour& m_tour;
+
+    public:
+        AnnealingMoves(const CityCoordinates& coordinates, const CandidateLists& candidateLists, Tour& tour)
+            : m_coordinates(coordinates), m_candidateLists(candidateLists), m_tour(tour) {};
+
+        // Draws a move and applies it when criterion accepts its delta. Returns the applied delta, 0 when nothing changed.
+        template <typename Accept>
+        double tryRandomMove(FastRandom& random, Accept accept)
+        {
+            const uint32_t city = random.nextBelow(m_tour.getNumberOfCities());
+            const std::span<const uint32_t> candidates = m_candidateLists.getNeighbors(city);
+            if (candidates.empty())
+            {
+                return 0.0;
+            }
+            const uint32_t candidate = candidates[random.nextBelow(candidates.size())];
+
+            const uint32_t bits = random.nextBelow(16);
+            const bool isForward = (bits & 1) != 0;
+            if ((bits & 2) != 0)
+            {
+                return tryTwoOptMove(city, candidate, isForward, accept);
+            }
+            return tryOrOptMove(city, candidate, 1 + (bits >> 2) % Route::MAX_MOVED_SEGMENT_LENGTH, isForward, (bits & 8) != 0, accept);
+        };
+
+    private:
+        uint32_t getSuccessor(uint32_t city, bool isForward) const { return isForward ? m_tour.next(city) : m_tour.prev(city); };
+        uint32_t getPredecessor(uint32_t city, bool isForward) const { return isForward ? m_tour.prev(city) : m_tour.next(city); };
+        double getDistance(uint32_t first, uint32_t second) const { return m_coordinates.getDistance(first, second); };
+
+        // Replaces (city, successor) and (candidate, its successor) with (city, candidate) and the edge between the successors
+        template <typename Accept>
+        double tryTwoOptMove(uint32_t a, uint32_t c, bool isForward, Accept accept)
+        {
+            const uint32_t b = getSuccessor(a, isForward);
+            const uint32_t d = getSuccessor(c, isForward);
+            if (c == b || d == a)
+            {
+                return 0.0;
+            }
+
+            const double routeLengthDelta = getDistance(a, c) + getDistance(b, d) - getDistance(a, b) - getDistance(c, d);
+            if (!accept(routeLengthDelta))
+            {
+                return 0.0;
+            }
+
+            applyTwoOptMove(m_tour, a, b, c, d);
+            return routeLengthDelta;
+        };
+
+        // Moves the segment of segmentLength cities starting at first next to candidate, either after candidate keeping its
+        // direction or before candidate reversed, so that first ends up adjacent to candidate either way
+        template <typename Accept>
+        double tryOrOptMove(uint32_t first, uint32_t candidate, uint32_t segmentLength, bool isForward, bool isAfterCandidate, Accept accept)
+        {
+            uint32_t segment[Route::MAX_MOVED_SEGMENT_LENGTH] = { first };
+            for (uint32_t i = 1; i < segmentLength; ++i)
+            {
+                segment[i] = getSuccessor(segment[i - 1], isForward);
+            }
+            const uint32_t last = segment[segmentLength - 1];
+            const uint32_t segmentPrev = getPredecessor(first, isForward);
+            const uint32_t segmentNext = getSuccessor(last, isForward);
+
+            // The segment goes between target and targetNext
+            const uint32_t target = isAfterCandidate ? candidate : getPredecessor(candidate, isForward);
+            const uint32_t targetNext = getSuccessor(target, isForward);
+            auto isInSegment = [&](uint32_t city) { return std::find(segment, segment + segmentLength, city) != segment + segmentLength; };
+            if (segmentPrev == segmentNext || isInSegment(target) || isInSegment(targetNext))
+            {
+                return 0.0;
+            }
+
+            const double insertionLength = isAfterCandidate ? getDistance(target, first) + getDistance(last, targetNext)
+                : getDistance(target, last) + getDistance(first, targetNext);
+            const double routeLengthDelta = getDistance(segmentPrev, segmentNext) + insertionLength - getDistance(segmentPrev, first)
+                - getDistance(last, segmentNext) - getDistance(target, targetNext);
+            if (!accept(routeLengthDelta))
+            {
+                return 0.0;
+            }
+
+            // segmentPrev [first..last] segmentNext .. target targetNext becomes segmentPrev segmentNext .. target [last..first] targetNext
+            // after two 2-opt moves, a third one turns the segment around
+            applyTwoOptMove(m_tour, segmentPrev, first, target, targetNext);
+            applyTwoOptMove(m_tour, segmentPrev, target, segmentNext, last);
+            if (isAfterCandidate)
+            {
+                applyTwoOptMove(m_tour, target, last, first, targetNext);
+            }
+            return routeLengthDelta;
+        };
+    };
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::simulatedAnnealingAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        seededRandomRoute(coordinates, settings.seed, route, routeLength);
+    }
+
+    // The segment, its two tour neighbors and the two cities it is placed between have to be distinct. Smaller tours
+    // only get the Lin-Kernighan descent.
+    const uint32_t numberOfCities = route.getNumberOfCities();
+    if (numberOfCities < Route::MAX_MOVED_SEGMENT_LENGTH + 3)
+    {
+        linKernighanAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t iterations = settings.annealingIterations > 0 ? settings.annealingIterations
+        : static_cast<uint64_t>(DEFAULT_ANNEALING_MOVES_PER_CITY) * numberOfCities;
+
+    double startTemperature;
+    double endTemperature;
+    getAnnealingTemperatures(coordinates, candidateLists, settings, startTemperature, endTemperature);
+    const double logTemperatureRatio = std::log(endTemperature / startTemperature);
+
+    FastRandom random(settings.seed);
+    const MetropolisCriterion criterion;
+
+    improveOnFastestTour(route, [&](auto& tour)
+    {
+        AnnealingMoves<std::remove_reference_t<decltype(tour)>> moves(coordinates, candidateLists, tour);
+
+        double inverseTemperature = 1.0 / startTemperature;
+        auto accept = [&](double routeLengthDelta) { return criterion.isAccepted(routeLengthDelta, inverseTemperature, random); };
+
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            // The schedule follows whichever of the iteration and time budgets is used up further
+            if (iteration % ANNEALING_SCHEDULE_INTERVAL == 0)
+            {
+                if (isInterrupt)
+                {
+                    return;
+                }
+
+                double progress = static_cast<double>(iteration) / iterations;
+                if (settings.hasDeadline())
+                {
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now >= settings.deadline)
+                    {
+                        return;
+                    }
+                    progress = std::max(progress, std::chrono::duration<double>(now - start) / (settings.deadline - start));
+                }
+                inverseTemperature = 1.0 / (startTemperature * std::exp(progress * logTemperatureRatio));
+
+                if constexpr (Visualization::IS_ANIMATED)
+                {
+                    if constexpr (std::is_same_v<std::remove_reference_t<decltype(tour)>, TwoLevelTour>)
+                    {
+                        tour.writeTo(route);
+                    }
+                    visualization.waitTimeStep();
+                }
+            }
+
+            const double routeLengthDelta = moves.tryRandomMove(random, accept);
+            if (routeLengthDelta != 0.0)
+            {
+                routeLength.add(routeLengthDelta);
+                routeLength.resynchronize(coordinates, tour);
+            }
+        }
+    });
+}
+
+namespace
+{
+    // One chain of parallel tempering with its own tour, length and random numbers. The chains never exchange tours,
+    // only the indices into the temperature ladder.
+    template <typename Tour>
+    struct TemperingReplica
+    {
+        Tour tour;
+        RouteLength routeLength;
+        FastRandom random;
+        uint32_t level;
+
+        TemperingReplica(const Route& route, const RouteLength& startLength, uint64_t seed, uint32_t startLevel)
+            : routeLength(startLength), random(seed), level(startLevel)
+        {
+            if constexpr (std::is_same_v<Tour, TwoLevelTour>)
+            {
+                tour.build(route);
+            }
+            else
+            {
+                tour = route;
+            }
+        };
+
+        void writeTo(Route& route) const
+        {
+            if constexpr (std::is_same_v<Tour, TwoLevelTour>)
+            {
+                tour.writeTo(route);
+            }
+            else
+            {
+                route = tour;
+            }
+        };
+    };
+
+    template <typename Tour, typename Visualization>
+    void runParallelTempering(Visualization& visualization, const std::atomic<bool>& isInterrupt, const CityCoordinates& coordinates,
+        const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength)
+    {
+        const uint32_t numberOfCities = route.getNumberOfCities();
+        const unsigned int numberOfReplicas = std::max(2u, settings.numberOfWorkerThreads > 0 ? settings.numberOfWorkerThreads : std::thread::hardware_concurrency());
+
+        // Geometric ladder with level 0 the coldest
+        double startTemperature;
+        double endTemperature;
+        getAnnealingTemperatures(coordinates, candidateLists, settings, startTemperature, endTemperature);
+        std::vector<double> inverseTemperatures(numberOfReplicas);
+        for (uint32_t level = 0; level < numberOfReplicas; ++level)
+        {
+            inverseTemperatures[level] = 1.0 / (endTemperature * std::pow(startTemperature / endTemperature, static_cast<double>(level) / (numberOfReplicas - 1)));
+        }
+
+        std::vector<TemperingReplica<Tour>> replicas;
+        replicas.reserve(numberOfReplicas);
+        for (uint32_t replica = 0; replica < numberOfReplicas; ++replica)
+        {
+            replicas.emplace_back(route, routeLength, settings.seed + replica, replica);
+        }
+
+        // Every replica makes a sweep of numberOfCities moves between two exchange rounds
+        const uint64_t iterations = settings.annealingIterations > 0 ? settings.annealingIterations
+            : static_cast<uint64_t>(TravelingSalesmanAlgorithms::DEFAULT_ANNEALING_MOVES_PER_CITY) * numberOfCities;
+        const uint64_t numberOfSweeps = std::max<uint64_t>(1, iterations / numberOfCities);
+
+        const MetropolisCriterion criterion;
+        FastRandom exchangeRandom(settings.seed ^ 0x5851f42d4c957f2dull);
+        std::vector<uint32_t> replicaAtLevel(numberOfReplicas);
+        uint64_t sweep = 0;
+        bool isStopping = false;
+
+        // Runs on one thread once all replicas finished a sweep: swaps neighboring levels, alternating between even and
+        // odd pairs, with probability min(1, exp((beta_i - beta_j) (E_i - E_j))), and publishes the best tour
+        auto exchange = [&]() noexcept
+        {
+            for (uint32_t replica = 0; replica < numberOfReplicas; ++replica)
+            {
+                replicaAtLevel[replicas[replica].level] = replica;
+            }
+            for (uint32_t level = sweep % 2; level + 1 < numberOfReplicas; level += 2)
+            {
+                TemperingReplica<Tour>& colder = replicas[replicaAtLevel[level]];
+                TemperingReplica<Tour>& hotter = replicas[replicaAtLevel[level + 1]];
+                const double exponent = (inverseTemperatures[level] - inverseTemperatures[level + 1]) * (colder.routeLength.get() - hotter.routeLength.get());
+                if (exponent >= 0.0 || exchangeRandom.nextDouble() < std::exp(exponent))
+                {
+                    std::swap(colder.level, hotter.level);
+                }
+            }
+
+            const TemperingReplica<Tour>& best = *std::min_element(replicas.begin(), replicas.end(),
+                [](const TemperingReplica<Tour>& a, const TemperingReplica<Tour>& b) { return a.routeLength.get() < b.routeLength.get(); });
+            if (best.routeLength.get() < routeLength.get())
+            {
+                best.writeTo(route);
+                routeLength = best.routeLength;
+            }
+
+            ++sweep;
+            isStopping = sweep >= numberOfSweeps || isInterrupt || std::chrono::steady_clock::now() >= settings.deadline;
+
+            visualization.waitTimeStep();
+        };
+        std::barrier<decltype(exchange)> sweepBarrier(numberOfReplicas, exchange);
+
+        auto runReplica = [&](uint32_t index)
+        {
+            TemperingReplica<Tour>& replica = replicas[index];
+            AnnealingMoves<Tour> moves(coordinates, candidateLists, replica.tour);
+
+            while (!isStopping)
+            {
+                const double inverseTemperature = inverseTemperatures[replica.level];
+                auto accept = [&](double routeLengthDelta) { return criterion.isAccepted(routeLengthDelta, inverseTemperature, replica.random); };
+
+                for (uint32_t i = 0; i < numberOfCities; ++i)
+                {
+                    const double routeLengthDelta = moves.tryRandomMove(replica.random, accept);
+                    if (routeLengthDelta != 0.0)
+                    {
+                        replica.routeLength.add(routeLengthDelta);
+                        replica.routeLength.resynchronize(coordinates, replica.tour);
+                    }
+                }
+
+                sweepBarrier.arrive_and_wait();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32_t index = 1; index < numberOfReplicas; ++index)
+        {
+            workers.emplace_back(runReplica, index);
+        }
+        runReplica(0);
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::parallelTemperingAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        seededRandomRoute(coordinates, settings.seed, route, routeLength);
+    }
+
+    // Too small for the annealing moves, like in simulatedAnnealingAlgorithm only the Lin-Kernighan descent runs
+    if (route.getNumberOfCities() < Route::MAX_MOVED_SEGMENT_LENGTH + 3)
+    {
+        linKernighanAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        return;
+    }
+
+    if (route.getNumberOfCities() >= TwoLevelTour::MIN_NUMBER_OF_CITIES)
+    {
+        runParallelTempering<TwoLevelTour>(visualization, isInterrupt, coordinates, candidateLists, settings, route, routeLength);
+    }
+    else
+    {
+        runParallelTempering<Route>(visualization, isInterrupt, coordinates, candidateLists, settings, route, routeLength);
+    }
+}
+
+namespace
+{
+    // Forwards the tour queries to a Route or TwoLevelTour and records every flip as the 2-opt move it made, so a local
+    // search that did not pay off can be rolled back in time proportional to its own work instead of copying the tour
+    template <typename Tour>
+    class JournaledTour
+    {
+        struct Move
+        {
+            uint32_t a;
+            uint32_t b;
+            uint32_t c;
+            uint32_t d;
+        };
+
+        Tour& m_tour;
+        std::vector<Move> m_journal;
+
+        static bool isSameEdge(uint32_t a, uint32_t b, uint32_t c, uint32_t d) { return (a == c && b == d) || (a == d && b == c); };
+
+        // Whether move removes the two edges earlier added and adds the two it removed
+        static bool isUndoing(const Move& move, const Move& earlier)
+        {
+            const bool isRemovingAdded = (isSameEdge(move.a, move.b, earlier.a, earlier.c) && isSameEdge(move.c, move.d, earlier.b, earlier.d))
+                || (isSameEdge(move.a, move.b, earlier.b, earlier.d) && isSameEdge(move.c, move.d, earlier.a, earlier.c));
+            const bool isAddingRemoved = (isSameEdge(move.a, move.c, earlier.a, earlier.b) && isSameEdge(move.b, move.d, earlier.c, earlier.d))
+                || (isSameEdge(move.a, move.c, earlier.c, earlier.d) && isSameEdge(move.b, move.d, earlier.a, earlier.b));
+            return isRemovingAdded && isAddingRemoved;
+        };
+
+    public:
+        explicit JournaledTour(Tour& tour) : m_tour(tour) {};
+
+        // Lets RouteLength::resynchronize sum the underlying tour
+        operator const Tour&() const { return m_tour; };
+
+        uint32_t getNumberOfCities() const { return m_tour.getNumberOfCities(); };
+        uint32_t next(uint32_t city) const { return m_tour.next(city); };
+        uint32_t prev(uint32_t city) const { return m_tour.prev(city); };
+        bool between(uint32_t a, uint32_t b, uint32_t c) const { return m_tour.between(a, b, c); };
+
+        // A flip undoing the previous one, as the search does with every step that does not pay off, cancels its entry
+        void flip(uint32_t first, uint32_t last)
+        {
+            const uint32_t before = m_tour.prev(first);
+            const uint32_t after = m_tour.next(last);
+            m_tour.flip(first, last);
+            // Reversing the whole cycle leaves it unchanged
+            if (before == last)
+            {
+                return;
+            }
+
+            const Move move = { before, first, last, after };
+            if (!m_journal.empty() && isUndoing(move, m_journal.back()))
+            {
+                m_journal.pop_back();
+            }
+            else
+            {
+                m_journal.push_back(move);
+            }
+        };
+
+        void clearJournal() { m_journal.clear(); };
+
+        // Each flip replaced (a, b) and (c, d) with (a, c) and (b, d), c now following a and d following b
+        void rollBack()
+        {
+            for (auto move = m_journal.rbegin(); move != m_journal.rend(); ++move)
+            {
+                applyTwoOptMove(m_tour, move->a, move->c, move->b, move->d);
+            }
+            m_journal.clear();
+        };
+    };
+
+    // Double bridge within a stretch of the tour: t1 [t2..t3][t4..t5] t6 becomes t1 [t4..t5][t2..t3] t6 for two segments of
+    // 1 to maxSegmentLength cities, carried out as three 2-opt moves. Returns the length delta, kickedCities gets t1 to t6.
+    template <typename Tour>
+    double applyDoubleBridgeKick(const CityCoordinates& coordinates, Tour& tour, FastRandom& random, uint32_t maxSegmentLength,
+        uint32_t (&kickedCities)[6])
+    {
+        const uint32_t t1 = random.nextBelow(tour.getNumberOfCities());
+        const uint32_t t2 = tour.next(t1);
+        uint32_t t3 = t2;
+        for (uint32_t i = random.nextBelow(maxSegmentLength); i > 0; --i)
+        {
+            t3 = tour.next(t3);
+        }
+        const uint32_t t4 = tour.next(t3);
+        uint32_t t5 = t4;
+        for (uint32_t i = random.nextBelow(maxSegmentLength); i > 0; --i)
+        {
+            t5 = tour.next(t5);
+        }
+        const uint32_t t6 = tour.next(t5);
+
+        // t1 [t5..t4][t3..t2] t6, then t1 [t4..t5][t3..t2] t6, then t1 [t4..t5][t2..t3] t6
+        applyTwoOptMove(tour, t1, t2, t5, t6);
+        applyTwoOptMove(tour, t1, t5, t4, t3);
+        applyTwoOptMove(tour, t5, t3, t2, t6);
+
+        kickedCities[0] = t1;
+        kickedCities[1] = t2;
+        kickedCities[2] = t3;
+        kickedCities[3] = t4;
+        kickedCities[4] = t5;
+        kickedCities[5] = t6;
+        return static_cast<double>(coordinates.getDistance(t1, t4)) + coordinates.getDistance(t5, t2) + coordinates.getDistance(t3, t6)
+            - coordinates.getDistance(t1, t2) - coordinates.getDistance(t3, t4) - coordinates.getDistance(t5, t6);
+    }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::iteratedLocalSearchAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        seededRandomRoute(coordinates, settings.seed, route, routeLength);
+    }
+
+    const uint32_t numberOfCities = route.getNumberOfCities();
+    if (numberOfCities < 4)
+    {
+        return;
+    }
+
+    // The two segments leave at least two cities outside of the kick. A double bridge needs eight distinct cities,
+    // smaller tours only get the descent.
+    const uint32_t maxSegmentLength = std::min(ILS_KICK_SEGMENT_LENGTH, (numberOfCities - 2) / 2);
+    const uint64_t numberOfKicks = numberOfCities < 8 ? 0 : settings.localSearchKicks > 0 ? settings.localSearchKicks
+        : static_cast<uint64_t>(DEFAULT_ILS_KICKS_PER_CITY) * numberOfCities;
+
+    improveOnFastestTour(route, [&](auto& tour)
+    {
+        using Tour = std::remove_reference_t<decltype(tour)>;
+
+        ActiveCityQueue activeCities;
+        activeCities.reset(numberOfCities);
+
+        LinKernighanSearch<Visualization, Tour> descent(visualization, coordinates, candidateLists, tour, routeLength);
+        while (!activeCities.isEmpty())
+        {
+            if (isInterrupt)
+            {
+                return;
+            }
+            descent.improve(activeCities.pop(), activeCities);
+        }
+
+        // Only the cities at the edges the kick changed are woken up, so the repair stays near the kick
+        JournaledTour<Tour> journaledTour(tour);
+        LinKernighanSearch<Visualization, JournaledTour<Tour>> repair(visualization, coordinates, candidateLists, journaledTour, routeLength);
+        FastRandom random(settings.seed);
+
+        for (uint64_t kick = 0; kick < numberOfKicks; ++kick)
+        {
+            if (isInterrupt || std::chrono::steady_clock::now() >= settings.deadline)
+            {
+                return;
+            }
+
+            const RouteLength lengthBeforeKick = routeLength;
+            uint32_t kickedCities[6];
+            routeLength.add(applyDoubleBridgeKick(coordinates, journaledTour, random, maxSegmentLength, kickedCities));
+            for (uint32_t city : kickedCities)
+            {
+                activeCities.push(city);
+            }
+
+            while (!activeCities.isEmpty())
+            {
+                repair.improve(activeCities.pop(), activeCities);
+            }
+
+            if (routeLength.get() < lengthBeforeKick.get())
+            {
+                journaledTour.clearJournal();
+                visualization.waitTimeStep();
+            }
+            else
+            {
+                journaledTour.rollBack();
+                routeLength = lengthBeforeKick;
+            }
+        }
+    });
+}
+
+namespace
+{
+    // Edge assembly crossover (EAX) of two parent tours A and B with one AB-cycle per child. The edges the parents do not
+    // share are split into AB-cycles, closed walks alternating between an edge of A and an edge of B. A child is A with
+    // the A edges of one AB-cycle replaced by its B edges, which keeps every degree at two but may break the tour into
+    // subtours; those are merged smallest first by the cheapest exchange of two edges towards a candidate neighbor.
+    // Each worker owns one of these, so a crossover allocates nothing once the buffers have grown.
+    class EdgeAssemblyCrossover
+    {
+        const CityCoordinates& m_coordinates;
+        const CandidateLists& m_candidateLists;
+        uint32_t m_numberOfCities;
+
+        // Neighbors of each city in parent A and B, and in the child under construction
+        std::vector<std::array<uint32_t, 2>> m_edgesA;
+        std::vector<std::array<uint32_t, 2>> m_edgesB;
+        std::vector<std::array<uint32_t, 2>> m_links;
+
+        // Edges of one parent the other parent lacks, per city, while the AB-cycles are taken apart
+        std::vector<std::array<uint32_t, 2>> m_remainingA;
+        std::vector<std::array<uint32_t, 2>> m_remainingB;
+        std::vector<uint32_t> m_path;
+        std::vector<uint32_t> m_pathPositions[2];
+
+        // AB-cycle c is m_cycleCities[m_cycleOffsets[c] .. m_cycleOffsets[c + 1]), the edge from an even index is an A edge
+        std::vector<uint32_t> m_cycleCities;
+        std::vector<uint32_t> m_cycleOffsets;
+
+        struct Subtour
+        {
+            uint32_t city;
+            uint32_t size;
+        };
+
+        std::vector<uint32_t> m_subtourOf;
+        std::vector<Subtour> m_subtours;
+
+    public:
+        EdgeAssemblyCrossover(const CityCoordinates& coordinates, const CandidateLists& candidateLists)
+            : m_coordinates(coordinates), m_candidateLists(candidateLists), m_numberOfCities(coordinates.size())
+        {
+            m_edgesA.resize(m_numberOfCities);
+            m_edgesB.resize(m_numberOfCities);
+            m_links.resize(m_numberOfCities);
+            m_remainingA.resize(m_numberOfCities);
+            m_remainingB.resize(m_numberOfCities);
+            m_pathPositions[0].assign(m_numberOfCities, NO_CITY);
+            m_pathPositions[1].assign(m_numberOfCities, NO_CITY);
+            m_subtourOf.resize(m_numberOfCities);
+        };
+
+        // Splits the edges of parentA and parentB, given as city sequences, into AB-cycles, returns their number
+        uint32_t decompose(std::span<const uint32_t> parentA, std::span<const uint32_t> parentB, FastRandom& random)
+        {
+            storeEdges(parentA, m_edgesA);
+            storeEdges(parentB, m_edgesB);
+
+            for (uint32_t city = 0; city < m_numberOfCities; ++city)
+            {
+                for (int side = 0; side < 2; ++side)
+                {
+                    const uint32_t neighborA = m_edgesA[city][side];
+                    const uint32_t neighborB = m_edgesB[city][side];
+                    m_remainingA[city][side] = isEdge(m_edgesB, city, neighborA) ? NO_CITY : neighborA;
+                    m_remainingB[city][side] = isEdge(m_edgesA, city, neighborB) ? NO_CITY : neighborB;
+                }
+            }
+
+            m_cycleCities.clear();
+            m_cycleOffsets.assign(1, 0);
+
+            // Walk from every city with unused A edges, alternating A and B edges starting with A, so the edge leaving
+            // path index i is an A edge for even i. Arriving at a city already on the path at an index of the same parity
+            // closes an alternating cycle, which is cut off the path.
+            for (uint32_t start = 0; start < m_numberOfCities; ++start)
+            {
+                while (hasEdge(m_remainingA, start))
+                {
+                    m_path.assign(1, start);
+                    m_pathPositions[0][start] = 0;
+
+                    while (!m_path.empty())
+                    {
+                        const uint32_t index = m_path.size() - 1;
+                        const uint32_t city = m_path[index];
+                        const bool isEdgeA = index % 2 == 0;
+                        std::vector<std::array<uint32_t, 2>>& remaining = isEdgeA ? m_remainingA : m_remainingB;
+                        // Only the start can run out: each city has as many unshared A edges as B edges and every pass
+                        // of the walk through it uses one of each, so any other path end has an edge of the type it needs
+                        if (!hasEdge(remaining, city))
+                        {
+                            m_pathPositions[0][city] = NO_CITY;
+                            m_path.clear();
+                            break;
+                        }
+
+                        const uint32_t next = takeEdge(remaining, city, random);
+                        const uint32_t nextIndex = index + 1;
+                        const uint32_t earlierIndex = m_pathPositions[nextIndex % 2][next];
+                        if (earlierIndex == NO_CITY)
+                        {
+                            m_path.push_back(next);
+                            m_pathPositions[nextIndex % 2][next] = nextIndex;
+                            continue;
+                        }
+
+                        // The cycle is m_path[earlierIndex .. index] and the edge back to next, rotated to begin with an A edge
+                        const uint32_t cycleStart = earlierIndex % 2 == 0 ? earlierIndex : earlierIndex + 1;
+                        m_cycleCities.insert(m_cycleCities.end(), m_path.begin() + cycleStart, m_path.end());
+                        if (cycleStart != earlierIndex)
+                        {
+                            m_cycleCities.push_back(next);
+                        }
+                        m_cycleOffsets.push_back(m_cycleCities.size());
+
+                        for (uint32_t removed = earlierIndex + 1; removed < m_path.size(); ++removed)
+                        {
+                            m_pathPositions[removed % 2][m_path[removed]] = NO_CITY;
+                        }
+                        m_path.resize(earlierIndex + 1);
+                    }
+                }
+            }
+
+            return m_cycleOffsets.size() - 1;
+        };
+
+        // Builds the child of parentA, the same tour as passed to decompose, with the given AB-cycle applied and its
+        // subtours merged. Writes its cities to child, adds the cities whose edges changed to changedCities and returns
+        // the length delta to parentA.
+        double assembleChild(std::span<const uint32_t> parentA, uint32_t cycle, std::vector<uint32_t>& child, std::vector<uint32_t>& changedCities)
+        {
+            std::copy(m_edgesA.begin(), m_edgesA.end(), m_links.begin());
+
+            const uint32_t begin = m_cycleOffsets[cycle];
+            const uint32_t end = m_cycleOffsets[cycle + 1];
+            double routeLengthDelta = 0.0;
+            for (uint32_t i = begin; i < end; i += 2)
+            {
+                const uint32_t first = m_cycleCities[i];
+                const uint32_t second = m_cycleCities[i + 1];
+                replaceLink(first, second, NO_CITY);
+                replaceLink(second, first, NO_CITY);
+                routeLengthDelta -= m_coordinates.getDistance(first, second);
+            }
+            for (uint32_t i = begin + 1; i < end; i += 2)
+            {
+                const uint32_t first = m_cycleCities[i];
+                const uint32_t second = m_cycleCities[i + 1 < end ? i + 1 : begin];
+                replaceLink(first, NO_CITY, second);
+                replaceLink(second, NO_CITY, first);
+                routeLengthDelta += m_coordinates.getDistance(first, second);
+            }
+            changedCities.insert(changedCities.end(), m_cycleCities.begin() + begin, m_cycleCities.begin() + end);
+
+            // Label the subtours walking the cities in the order of A, so the labels come out in runs
+            m_subtours.clear();
+            std::fill(m_subtourOf.begin(), m_subtourOf.end(), NO_CITY);
+            for (uint32_t city : parentA)
+            {
+                if (m_subtourOf[city] == NO_CITY)
+                {
+                    const uint32_t size = labelSubtour(city, m_subtours.size());
+                    m_subtours.push_back({ city, size });
+                }
+            }
+
+            for (uint32_t numberOfSubtours = m_subtours.size(); numberOfSubtours > 1; --numberOfSubtours)
+            {
+                routeLengthDelta += mergeSmallestSubtour(changedCities);
+            }
+
+            child.clear();
+            uint32_t previous = m_links[0][1];
+            for (uint32_t city = 0; child.size() < m_numberOfCities; )
+            {
+                child.push_back(city);
+                const uint32_t next = m_links[city][0] != previous ? m_links[city][0] : m_links[city][1];
+                previous = city;
+                city = next;
+            }
+
+            return routeLengthDelta;
+        };
+
+    private:
+        void storeEdges(std::span<const uint32_t> tour, std::vector<std::array<uint32_t, 2>>& edges) const
+        {
+            for (uint32_t position = 0; position < m_numberOfCities; ++position)
+            {
+                edges[tour[position]] = { tour[position == 0 ? m_numberOfCities - 1 : position - 1], tour[position + 1 == m_numberOfCities ? 0 : position + 1] };
+            }
+        };
+
+        static bool isEdge(const std::vector<std::array<uint32_t, 2>>& edges, uint32_t city, uint32_t neighbor)
+        {
+            return edges[city][0] == neighbor || edges[city][1] == neighbor;
+        };
+
+        static bool hasEdge(const std::vector<std::array<uint32_t, 2>>& remaining, uint32_t city)
+        {
+            return remaining[city][0] != NO_CITY || remaining[city][1] != NO_CITY;
+        };
+
+        // Removes one of the remaining edges of city, a random one if it has two, from both of its ends
+        static uint32_t takeEdge(std::vector<std::array<uint32_t, 2>>& remaining, uint32_t city, FastRandom& random)
+        {
+            std::array<uint32_t, 2>& neighbors = remaining[city];
+            int side = neighbors[0] == NO_CITY ? 1 : 0;
+            if (neighbors[0] != NO_CITY && neighbors[1] != NO_CITY)
+            {
+                side = random.nextBelow(2);
+            }
+            const uint32_t neighbor = neighbors[side];
+            neighbors[side] = NO_CITY;
+            std::array<uint32_t, 2>& backwards = remaining[neighbor];
+            backwards[backwards[0] == city ? 0 : 1] = NO_CITY;
+            return neighbor;
+        };
+
+        void replaceLink(uint32_t city, uint32_t oldNeighbor, uint32_t newNeighbor)
+        {
+            std::array<uint32_t, 2>& links = m_links[city];
+            links[links[0] == oldNeighbor ? 0 : 1] = newNeighbor;
+        };
+
+        uint32_t labelSubtour(uint32_t start, uint32_t subtour)
+        {
+            uint32_t size = 0;
+            uint32_t previous = m_links[start][1];
+            uint32_t city = start;
+            do
+            {
+                m_subtourOf[city] = subtour;
+                ++size;
+                const uint32_t next = m_links[city][0] != previous ? m_links[city][0] : m_links[city][1];
+                previous = city;
+                city = next;
+            } while (city != start);
+            return size;
+        };
+
+        // Joins the smallest subtour to another one by the cheapest exchange of an edge (c, c') of it and an edge (d, d')
+        // of the other for (c, d) and (c', d'), d a candidate of c. Returns the length delta.
+        double mergeSmallestSubtour(std::vector<uint32_t>& changedCities)
+        {
+            uint32_t smallest = NO_CITY;
+            for (uint32_t subtour = 0; subtour < m_subtours.size(); ++subtour)
+            {
+                if (m_subtours[subtour].size > 0 && (smallest == NO_CITY || m_subtours[subtour].size < m_subtours[smallest].size))
+                {
+                    smallest = subtour;
+                }
+            }
+
+            double bestDelta = std::numeric_limits<double>::max();
+            uint32_t best[4] = { NO_CITY, NO_CITY, NO_CITY, NO_CITY };
+            forEachSubtourCity(m_subtours[smallest].city, [&](uint32_t c)
+            {
+                for (uint32_t d : m_candidateLists.getNeighbors(c))
+                {
+                    if (m_subtourOf[d] == smallest)
+                    {
+                        continue;
+                    }
+                    for (uint32_t cNeighbor : m_links[c])
+                    {
+                        for (uint32_t dNeighbor : m_links[d])
+                        {
+                            const double delta = static_cast<double>(m_coordinates.getDistance(c, d)) + m_coordinates.getDistance(cNeighbor, dNeighbor)
+                                - m_coordinates.getDistance(c, cNeighbor) - m_coordinates.getDistance(d, dNeighbor);
+                            if (delta < bestDelta)
+                            {
+                                bestDelta = delta;
+                                best[0] = c;
+                                best[1] = cNeighbor;
+                                best[2] = d;
+                                best[3] = dNeighbor;
+                            }
+                        }
+                    }
+                }
+            });
+
+            // No candidate leaves the subtour: join it to any other one, the repair has to clean up after that
+            if (best[0] == NO_CITY)
+            {
+                best[0] = m_subtours[smallest].city;
+                best[1] = m_links[best[0]][0];
+                for (const Subtour& subtour : m_subtours)
+                {
+                    if (subtour.size > 0 && &subtour != &m_subtours[smallest])
+                    {
+                        best[2] = subtour.city;
+                        break;
+                    }
+                }
+                best[3] = m_links[best[2]][0];
+                bestDelta = static_cast<double>(m_coordinates.getDistance(best[0], best[2])) + m_coordinates.getDistance(best[1], best[3])
+                    - m_coordinates.getDistance(best[0], best[1]) - m_coordinates.getDistance(best[2], best[3]);
+            }
+
+            const uint32_t target = m_subtourOf[best[2]];
+            forEachSubtourCity(m_subtours[smallest].city, [&](uint32_t city) { m_subtourOf[city] = target; });
+            m_subtours[target].size += m_subtours[smallest].size;
+            m_subtours[smallest].size = 0;
+
+            replaceLink(best[0], best[1], best[2]);
+            replaceLink(best[2], best[3], best[0]);
+            replaceLink(best[1], best[0], best[3]);
+            replaceLink(best[3], best[2], best[1]);
+            changedCities.insert(changedCities.end(), best, best + 4);
+
+            return bestDelta;
+        };
+
+        template <typename Visit>
+        void forEachSubtourCity(uint32_t start, Visit visit) const
+        {
+            uint32_t previous = m_links[start][1];
+            uint32_t city = start;
+            do
+            {
+                visit(city);
+                const uint32_t next = m_links[city][0] != previous ? m_links[city][0] : m_links[city][1];
+                previous = city;
+                city = next;
+            } while (city != start);
+        };
+    };
+
+    // The individuals of the genetic algorithm in one block, slot s holds a city sequence at [s * n, (s + 1) * n)
+    class PopulationArena
+    {
+        uint32_t m_numberOfCities = 0;
+        std::vector<uint32_t> m_cities;
+        std::vector<double> m_lengths;
+
+    public:
+        void reset(uint32_t numberOfSlots, uint32_t numberOfCities)
+        {
+            m_numberOfCities = numberOfCities;
+            m_cities.assign(static_cast<size_t>(numberOfSlots) * numberOfCities, 0);
+            m_lengths.assign(numberOfSlots, 0.0);
+        };
+
+        std::span<uint32_t> getTour(uint32_t slot) { return std::span<uint32_t>(m_cities.data() + static_cast<size_t>(slot) * m_numberOfCities, m_numberOfCities); };
+        std::span<const uint32_t> getTour(uint32_t slot) const
+        {
+            return std::span<const uint32_t>(m_cities.data() + static_cast<size_t>(slot) * m_numberOfCities, m_numberOfCities);
+        };
+        double getLength(uint32_t slot) const { return m_lengths[slot]; };
+        void setLength(uint32_t slot, double length) { m_lengths[slot] = length; };
+    };
+
+    // Local search from the queued cities on a copy of a city sequence, with the buffers kept between calls
+    struct TourRepair
+    {
+        Route route;
+        TwoLevelTour twoLevelTour;
+        ActiveCityQueue activeCities;
+
+        explicit TourRepair(uint32_t numberOfCities)
+        {
+            activeCities.reset(numberOfCities, false);
+        };
+
+        // Improves the city sequence tour of the given length by 2-opt with neighbor lists, or by Lin-Kernighan when
+        // isLinKernighan, and leaves the result in route. Returns its length.
+        double apply(const CityCoordinates& coordinates, const CandidateLists& candidateLists, std::span<const uint32_t> tour, double length,
+            bool isLinKernighan = false)
+        {
+            route.reset(tour.size());
+            for (uint32_t city : tour)
+            {
+                route.append(city);
+            }
+
+            RouteLength routeLength;
+            routeLength.reset(coordinates);
+            routeLength.add(length);
+
+            NoVisualization visualization;
+            auto improve = [&](auto& tour)
+            {
+                if (isLinKernighan)
+                {
+                    LinKernighanSearch<NoVisualization, std::remove_reference_t<decltype(tour)>> search(visualization, coordinates, candidateLists, tour, routeLength);
+                    while (!activeCities.isEmpty())
+                    {
+                        search.improve(activeCities.pop(), activeCities);
+                    }
+                }
+                while (!activeCities.isEmpty())
+                {
+                    applyTwoOptNeighborMove(visualization, coordinates, candidateLists, tour, activeCities, activeCities.pop(), routeLength);
+                }
+            };
+
+            if (route.getNumberOfCities() >= TwoLevelTour::MIN_NUMBER_OF_CITIES)
+            {
+                twoLevelTour.build(route);
+                improve(twoLevelTour);
+                twoLevelTour.writeTo(route);
+            }
+            else
+            {
+                improve(route);
+            }
+            return routeLength.get();
+        };
+    };
+
+    // Scratch memory of one worker thread of the genetic algorithm
+    struct GeneticWorker
+    {
+        EdgeAssemblyCrossover crossover;
+        TourRepair repair;
+        std::vector<uint32_t> child;
+        std::vector<uint32_t> bestChild;
+        std::vector<uint32_t> changedCities;
+        std::vector<uint32_t> cycles;
+
+        GeneticWorker(const CityCoordinates& coordinates, const CandidateLists& candidateLists)
+            : crossover(coordinates, candidateLists), repair(coordinates.size()) {};
+    };
+
+    void shuffle(std::vector<uint32_t>& values, FastRandom& random)
+    {
+        for (uint32_t i = values.size(); i > 1; --i)
+        {
+            std::swap(values[i - 1], values[random.nextBelow(i)]);
+        }
+    }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::geneticAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength)
+{
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        seededRandomRoute(coordinates, settings.seed, route, routeLength);
+    }
+
+    // Too small for the double bridge kicks that seed the population, the route only gets the repair
+    const uint32_t numberOfCities = route.getNumberOfCities();
+    if (numberOfCities < 8)
+    {
+        twoOptNeighborListAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        return;
+    }
+
+    const uint32_t populationSize = std::max(2u, settings.populationSize > 0 ? settings.populationSize : DEFAULT_GA_POPULATION_SIZE);
+    auto isStopping = [&]() { return isInterrupt || std::chrono::steady_clock::now() >= settings.deadline; };
+
+    ThreadPool pool(settings.numberOfWorkerThreads);
+    std::vector<GeneticWorker> workers;
+    workers.reserve(pool.getNumberOfWorkers());
+    for (unsigned int worker = 0; worker < pool.getNumberOfWorkers(); ++worker)
+    {
+        workers.emplace_back(coordinates, candidateLists);
+    }
+
+    // Two generations side by side, the parents are read from one while the next generation is written to the other
+    PopulationArena arena;
+    arena.reset(2 * populationSize, numberOfCities);
+    uint32_t parents = 0;
+    uint32_t offspring = populationSize;
+
+    // The start route taken to a 2-opt optimum is the first individual, the others are copies of it scattered by local
+    // double bridge kicks and repaired around the kicked cities
+    const std::span<uint32_t> seed = arena.getTour(0);
+    workers[0].repair.activeCities.reset(numberOfCities);
+    arena.setLength(0, workers[0].repair.apply(coordinates, candidateLists, route.getCities(), routeLength.get()));
+    std::copy(workers[0].repair.route.getCities().begin(), workers[0].repair.route.getCities().end(), seed.begin());
+    const uint32_t maxSegmentLength = std::min(ILS_KICK_SEGMENT_LENGTH, (numberOfCities - 2) / 2);
+    const uint32_t numberOfKicks = numberOfCities / GA_INITIAL_KICK_INTERVAL;
+    pool.run(populationSize - 1, [&](uint32_t task, unsigned int worker)
+    {
+        GeneticWorker& scratch = workers[worker];
+        FastRandom random(settings.seed + task);
+
+        Route& kickedRoute = scratch.repair.route;
+        kickedRoute.reset(numberOfCities);
+        for (uint32_t city : seed)
+        {
+            kickedRoute.append(city);
+        }
+        double kickedLength = arena.getLength(0);
+        for (uint32_t kick = 0; kick < numberOfKicks; ++kick)
+        {
+            uint32_t kickedCities[6];
+            kickedLength += applyDoubleBridgeKick(coordinates, kickedRoute, random, maxSegmentLength, kickedCities);
+            for (uint32_t city : kickedCities)
+            {
+                scratch.repair.activeCities.push(city);
+            }
+        }
+
+        const std::span<uint32_t> individual = arena.getTour(task + 1);
+        std::copy(kickedRoute.getCities().begin(), kickedRoute.getCities().end(), individual.begin());
+        arena.setLength(task + 1, scratch.repair.apply(coordinates, candidateLists, individual, kickedLength));
+        std::copy(scratch.repair.route.getCities().begin(), scratch.repair.route.getCities().end(), individual.begin());
+    });
+
+    // Each generation pairs the individuals in a random cycle, every individual A produces up to GA_CHILDREN_PER_PAIR
+    // children with the next one B and is replaced by the best of them if that is shorter
+    FastRandom random(settings.seed);
+    std::vector<uint32_t> pairing(populationSize);
+    std::iota(pairing.begin(), pairing.end(), 0);
+    for (uint64_t generation = 0; settings.geneticGenerations == 0 || generation < settings.geneticGenerations; ++generation)
+    {
+        if (isStopping())
+        {
+            break;
+        }
+
+        shuffle(pairing, random);
+        std::atomic<uint32_t> numberOfReplacements = 0;
+        pool.run(populationSize, [&](uint32_t task, unsigned int worker)
+        {
+            GeneticWorker& scratch = workers[worker];
+            FastRandom taskRandom(settings.seed + (generation + 1) * populationSize + task);
+            const std::span<const uint32_t> parentA = arena.getTour(parents + pairing[task]);
+            const std::span<const uint32_t> parentB = arena.getTour(parents + pairing[(task + 1) % populationSize]);
+            const double lengthA = arena.getLength(parents + pairing[task]);
+            double bestLength = lengthA;
+
+            if (!isStopping())
+            {
+                scratch.cycles.resize(scratch.crossover.decompose(parentA, parentB, taskRandom));
+                std::iota(scratch.cycles.begin(), scratch.cycles.end(), 0);
+                shuffle(scratch.cycles, taskRandom);
+
+                for (uint32_t i = 0; i < std::min<uint32_t>(GA_CHILDREN_PER_PAIR, scratch.cycles.size()) && !isStopping(); ++i)
+                {
+                    scratch.changedCities.clear();
+                    const double routeLengthDelta = scratch.crossover.assembleChild(parentA, scratch.cycles[i], scratch.child, scratch.changedCities);
+                    for (uint32_t city : scratch.changedCities)
+                    {
+                        scratch.repair.activeCities.push(city);
+                    }
+
+                    const double childLength = scratch.repair.apply(coordinates, candidateLists, scratch.child, lengthA + routeLengthDelta);
+                    if (childLength < bestLength)
+                    {
+                        bestLength = childLength;
+                        scratch.bestChild = scratch.repair.route.getCities();
+                    }
+                }
+            }
+
+            const std::span<uint32_t> next = arena.getTour(offspring + pairing[task]);
+            if (bestLength < lengthA)
+            {
+                std::copy(scratch.bestChild.begin(), scratch.bestChild.end(), next.begin());
+                ++numberOfReplacements;
+            }
+            else
+            {
+                std::copy(parentA.begin(), parentA.end(), next.begin());
+            }
+            arena.setLength(offspring + pairing[task], bestLength);
+        });
+        std::swap(parents, offspring);
+
+        uint32_t best = parents;
+        for (uint32_t slot = parents; slot < parents + populationSize; ++slot)
+        {
+            best = arena.getLength(slot) < arena.getLength(best) ? slot : best;
+        }
+        if (arena.getLength(best) < routeLength.get())
+        {
+            route.reset(numberOfCities);
+            for (uint32_t city : arena.getTour(best))
+            {
+                route.append(city);
+            }
+            routeLength.recompute(coordinates, route);
+            visualization.waitTimeStep();
+        }
+
+        // The population has converged, or at least EAX finds nothing to improve in any pair
+        if (numberOfReplacements == 0)
+        {
+            break;
+        }
+    }
+}
+
+namespace
+{
+    // Pheromone trails of the ant colony, one per candidate edge in the compressed rows of CandidateLists, so memory
+    // grows with n k instead of n^2. The trail of (i, j) is kept in the row of i and, when j also lists i, in the row of j.
+    class PheromoneTrails
+    {
+        const CandidateLists& m_candidateLists;
+        std::vector<float> m_trails;
+        float m_minTrail = 0.0f;
+        float m_maxTrail = 0.0f;
+
+    public:
+        explicit PheromoneTrails(const CandidateLists& candidateLists)
+            : m_candidateLists(candidateLists), m_trails(candidateLists.getNeighborArray().size()) {};
+
+        // Trail of the candidate edge at index entry of the neighbor array
+        float get(uint32_t entry) const { return m_trails[entry]; };
+
+        // MAX-MIN bounds for the best tour length so far, trails start at the upper one
+        void setBounds(double bestLength, uint32_t numberOfCities, bool isResetting)
+        {
+            m_maxTrail = static_cast<float>(1.0 / (TravelingSalesmanAlgorithms::ACO_EVAPORATION * bestLength));
+            m_minTrail = m_maxTrail / (2.0f * numberOfCities);
+            if (isResetting)
+            {
+                std::fill(m_trails.begin(), m_trails.end(), m_maxTrail);
+            }
+        };
+
+        void evaporate()
+        {
+            const float factor = static_cast<float>(1.0 - TravelingSalesmanAlgorithms::ACO_EVAPORATION);
+            for (float& trail : m_trails)
+            {
+                trail = std::max(trail * factor, m_minTrail);
+            }
+        };
+
+        // Adds 1 / length to the trails of the edges of tour
+        void deposit(std::span<const uint32_t> tour, double length)
+        {
+            const float amount = static_cast<float>(1.0 / length);
+            for (uint32_t position = 0; position < tour.size(); ++position)
+            {
+                const uint32_t city = tour[position];
+                const uint32_t next = tour[position + 1 == tour.size() ? 0 : position + 1];
+                add(city, next, amount);
+                add(next, city, amount);
+            }
+        };
+
+    private:
+        void add(uint32_t city, uint32_t neighbor, float amount)
+        {
+            const std::span<const uint32_t> candidates = m_candidateLists.getNeighbors(city);
+            const auto found = std::find(candidates.begin(), candidates.end(), neighbor);
+            if (found != candidates.end())
+            {
+                float& trail = m_trails[m_candidateLists.getOffsets()[city] + (found - candidates.begin())];
+                trail = std::min(trail + amount, m_maxTrail);
+            }
+        };
+    };
+
+    // Scratch memory of one worker thread of the ant colony
+    struct AntWorker
+    {
+        // Cities the current ant has not visited yet, for the step where all candidates are visited
+        KdTree unvisitedCities;
+        TourRepair repair;
+        // Step weights of the candidates of the current city, as long as the longest candidate list
+        std::vector<double> weights;
+
+        AntWorker(const CityCoordinates& coordinates, const CandidateLists& candidateLists) : repair(coordinates.size())
+        {
+            unvisitedCities.build(coordinates);
+
+            const std::vector<uint32_t>& offsets = candidateLists.getOffsets();
+            uint32_t maxNumberOfCandidates = 0;
+            for (uint32_t city = 0; city + 1 < offsets.size(); ++city)
+            {
+                maxNumberOfCandidates = std::max(maxNumberOfCandidates, offsets[city + 1] - offsets[city]);
+            }
+            weights.resize(maxNumberOfCandidates);
+        };
+
+        // Lets an ant walk from a random city, moving to an unvisited candidate of the current city with probability
+        // proportional to trail * heuristic, or to the nearest unvisited city once all candidates are visited.
+        // Writes the tour to the city sequence tour and returns its length.
+        double buildTour(const CityCoordinates& coordinates, const CandidateLists& candidateLists, const PheromoneTrails& trails,
+            const std::vector<float>& heuristics, FastRandom& random, std::span<uint32_t> tour)
+        {
+            const uint32_t numberOfCities = tour.size();
+            unvisitedCities.resetRemaining();
+
+            uint32_t city = random.nextBelow(numberOfCities);
+            tour[0] = city;
+            unvisitedCities.removeCity(city);
+            double length = 0.0;
+
+            for (uint32_t position = 1; position < numberOfCities; ++position)
+            {
+                const uint32_t offset = candidateLists.getOffsets()[city];
+                const std::span<const uint32_t> candidates = candidateLists.getNeighbors(city);
+
+                double weightSum = 0.0;
+                const uint32_t numberOfCandidates = candidates.size();
+                for (uint32_t i = 0; i < numberOfCandidates; ++i)
+                {
+                    weights[i] = unvisitedCities.isRemaining(candidates[i]) ? static_cast<double>(trails.get(offset + i)) * heuristics[offset + i] : 0.0;
+                    weightSum += weights[i];
+                }
+
+                uint32_t next = NO_CITY;
+                if (weightSum > 0.0 && random.nextDouble() < TravelingSalesmanAlgorithms::ACO_EXPLOITATION)
+                {
+                    next = candidates[std::max_element(weights.begin(), weights.begin() + numberOfCandidates) - weights.begin()];
+                }
+                else if (weightSum > 0.0)
+                {
+                    double threshold = random.nextDouble() * weightSum;
+                    for (uint32_t i = 0; i < numberOfCandidates; ++i)
+                    {
+                        if (weights[i] > 0.0)
+                        {
+                            next = candidates[i];
+                            threshold -= weights[i];
+                            if (threshold < 0.0)
+                            {
+                                break;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    next = unvisitedCities.findNearestRemaining(coordinates.getX(city), coordinates.getY(city));
+                }
+
+                tour[position] = next;
+                unvisitedCities.removeCity(next);
+                length += coordinates.getDistance(city, next);
+                city = next;
+            }
+
+            return length + coordinates.getDistance(city, tour[0]);
+        };
+    };
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::antColonyAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt,
+    const CityCoordinates& coordinates, const CandidateLists& candidateLists, const SearchSettings& settings, Route& route, RouteLength& routeLength)
+{
+    // The first trail bounds come from the start route, a nearest neighbor tour when there is none
+    if (!route.isComplete() || route.getNumberOfCities() != coordinates.size())
+    {
+        greedyAlgorithm(visualization, isInterrupt, coordinates, route, routeLength);
+    }
+
+    // Too small for a colony, the route only gets the Lin-Kernighan descent that repairs the ant tours
+    const uint32_t numberOfCities = route.getNumberOfCities();
+    if (numberOfCities < 8)
+    {
+        linKernighanAlgorithm(visualization, isInterrupt, coordinates, candidateLists, route, routeLength);
+        return;
+    }
+
+    const uint32_t numberOfAnts = std::max(1u, settings.numberOfAnts > 0 ? settings.numberOfAnts : DEFAULT_ACO_NUMBER_OF_ANTS);
+    const uint64_t numberOfIterations = settings.antIterations > 0 ? settings.antIterations : DEFAULT_ACO_ITERATIONS;
+    auto isStopping = [&]() { return isInterrupt || std::chrono::steady_clock::now() >= settings.deadline; };
+
+    // Heuristic desirability 1 / d^2 of every candidate edge, beside the trails
+    std::vector<float> heuristics(candidateLists.getNeighborArray().size());
+    for (uint32_t city = 0; city < numberOfCities; ++city)
+    {
+        const uint32_t offset = candidateLists.getOffsets()[city];
+        const std::span<const uint32_t> candidates = candidateLists.getNeighbors(city);
+        for (uint32_t i = 0; i < candidates.size(); ++i)
+        {
+            const float distance = coordinates.getDistance(city, candidates[i]);
+            heuristics[offset + i] = 1.0f / std::max(distance * distance, std::numeric_limits<float>::min());
+        }
+    }
+
+    PheromoneTrails trails(candidateLists);
+    trails.setBounds(routeLength.get(), numberOfCities, true);
+
+    ThreadPool pool(settings.numberOfWorkerThreads);
+    std::vector<AntWorker> workers;
+    workers.reserve(pool.getNumberOfWorkers());
+    for (unsigned int worker = 0; worker < pool.getNumberOfWorkers(); ++worker)
+    {
+        workers.emplace_back(coordinates, candidateLists);
+    }
+
+    // The tours of the ants, and the best tour so far in the last slot
+    PopulationArena arena;
+    arena.reset(numberOfAnts + 1, numberOfCities);
+    const uint32_t bestSlot = numberOfAnts;
+    std::copy(route.getCities().begin(), route.getCities().end(), arena.getTour(bestSlot).begin());
+    arena.setLength(bestSlot, routeLength.get());
+
+    for (uint64_t iteration = 0; iteration < numberOfIterations && !isStopping(); ++iteration)
+    {
+        // Every ant draws from its own generator seeded by iteration and ant, so runs repeat for any number of threads
+        pool.run(numberOfAnts, [&](uint32_t ant, unsigned int worker)
+        {
+            AntWorker& scratch = workers[worker];
+            FastRandom random(settings.seed + iteration * numberOfAnts + ant);
+            const std::span<uint32_t> tour = arena.getTour(ant);
+            if (isStopping())
+            {
+                arena.setLength(ant, std::numeric_limits<double>::max());
+                return;
+            }
+
+            const double length = scratch.buildTour(coordinates, candidateLists, trails, heuristics, random, tour);
+            scratch.repair.activeCities.reset(numberOfCities);
+            arena.setLength(ant, scratch.repair.apply(coordinates, candidateLists, tour, length, true));
+            std::copy(scratch.repair.route.getCities().begin(), scratch.repair.route.getCities().end(), tour.begin());
+        });
+
+        uint32_t iterationBest = 0;
+        for (uint32_t ant = 1; ant < numberOfAnts; ++ant)
+        {
+            iterationBest = arena.getLength(ant) < arena.getLength(iterationBest) ? ant : iterationBest;
+        }
+        if (arena.getLength(iterationBest) == std::numeric_limits<double>::max())
+        {
+            break;
+        }
+
+        if (arena.getLength(iterationBest) < arena.getLength(bestSlot))
+        {
+            const std::span<const uint32_t> tour = arena.getTour(iterationBest);
+            std::copy(tour.begin(), tour.end(), arena.getTour(bestSlot).begin());
+            arena.setLength(bestSlot, arena.getLength(iterationBest));
+            trails.setBounds(arena.getLength(bestSlot), numberOfCities, false);
+
+            route.reset(numberOfCities);
+            for (uint32_t city : tour)
+            {
+                route.append(city);
+            }
+            routeLength.recompute(coordinates, route);
+            visualization.waitTimeStep();
+        }
+
+        // MAX-MIN ant system: only one tour deposits, the iteration best and every ACO_BEST_TOUR_INTERVAL iterations
+        // the best so far, which balances exploring around new tours against converging on the best one
+        const uint32_t depositing = (iteration + 1) % ACO_BEST_TOUR_INTERVAL == 0 ? bestSlot : iterationBest;
+        trails.evaporate();
+        trails.deposit(arena.getTour(depositing), arena.getLength(depositing));
+    }
+}
+
+template <typename Visualization>
+void TravelingSalesmanAlgorithms::randomRouteAlgorithm(Visualization& visualization, const std::atomic<bool>& isInterrupt, 
+    const CityCoordinates& coordinates, Route& route, RouteLength& routeLength)
+{
+    route.reset(coordinates.size());
+
+    routeLength.reset(coordinates);
+
+    const uint32_t startPointIndex = 0;
+
+    uint32_t numberOfPoints = coordinates.size();
+
+    route.append(startPointIndex);
+
+    visualization.setOutgoingLineColor(startPointIndex, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+
+    std::random_device rd;
+    std::uniform_int_distribution<uint32_t> pointDistribution(0, numberOfPoints - 1);
+
+    while (route.size() < numberOfPoints)
+    {
+        if (isInterrupt)
+        {
+            return;
+        }
+
+        uint32_t randomPointIndex = pointDistribution(rd);
+
+        if (route.contains(randomPointIndex))
+        {
+            continue;
+        }
+        routeLength.add(coordinates.getDistance(route.at(route.size() - 1), randomPointIndex));
+        route.append(randomPointIndex);
+
+        visualization.setOutgoingLineColor(randomPointIndex, SolverColors::LINE_HIGHLIGHT_COLOR_A);
+        visualization.waitTimeStep();
+    }
+
+    routeLength.add(coordinates.getDistance(route.at(route.size() - 1), startPointIndex));
+}
+
+template void TravelingSalesmanAlgorithms::runAlgorithm<NoVisualization>(SolvingAlgorithm, NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&, const SearchSettings&);
+template void TravelingSalesmanAlgorithms::runAlgorithm<AnimatedVisualization>(SolvingAlgorithm, AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&, const SearchSettings&);
+
+template void TravelingSalesmanAlgorithms::greedyAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::greedyAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::greedyEdgeAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::greedyEdgeAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::savingsAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::savingsAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::spanningTreeAlgorithm<NoVisualization>(SolvingAlgorithm, NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::spanningTreeAlgorithm<AnimatedVisualization>(SolvingAlgorithm, AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::spaceFillingCurveAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::spaceFillingCurveAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::insertionAlgorithm<NoVisualization>(SolvingAlgorithm, NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::insertionAlgorithm<AnimatedVisualization>(SolvingAlgorithm, AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::twoOptAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::twoOptAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::twoOptNeighborListAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::twoOptNeighborListAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::orOptAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::orOptAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::linKernighanAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::linKernighanAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::simulatedAnnealingAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::simulatedAnnealingAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::parallelTemperingAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::parallelTemperingAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::iteratedLocalSearchAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::iteratedLocalSearchAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::geneticAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::geneticAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::antColonyAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::antColonyAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, const CandidateLists&, const SearchSettings&, Route&, RouteLength&);
+
+template void TravelingSalesmanAlgorithms::randomRouteAlgorithm<NoVisualization>(NoVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
+template void TravelingSalesmanAlgorithms::randomRouteAlgorithm<AnimatedVisualization>(AnimatedVisualization&, const std::atomic<bool>&,
+    const CityCoordinates&, Route&, RouteLength&);
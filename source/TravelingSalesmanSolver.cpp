@@ -1,6 +1,7 @@
 #include "TravelingSalesmanSolver.h"
 #include "TravelingSalesmanAlgorithms.h"
 #include "SolverColors.h"
+#include "CityPermutation.h"
 
 #include <random>
 #include <limits>
@@ -32,18 +33,29 @@ void TravelingSalesmanSolver::generatePoints(int numberOfPoints, float xMin, flo
 	std::uniform_real_distribution<double> xDistribution(xMin, xMax);
 	std::uniform_real_distribution<double> yDistribution(yMin, yMax);
 
-    m_route.clear();
-    m_points.clear();
+    m_route.reset(numberOfPoints);
+    m_routeLength.reset(m_coordinates);
+
+    CityCoordinates generatedCoordinates;
+    generatedCoordinates.reserve(numberOfPoints);
+    generatedCoordinates.setDistanceMode(m_coordinates.getDistanceMode());
 
     for (int i = 0; i < numberOfPoints; ++i)
     {
         float x = xDistribution(rd);
         float y = yDistribution(rd);
 
-        m_points.emplace_back(x, y);
+        generatedCoordinates.addCity(x, y);
     }
 
-    m_route.reserve(numberOfPoints + 1);
+    // The points are random, so numbering them along a Hilbert curve is invisible and keeps neighbors close in memory
+    CityPermutation permutation;
+    permutation.buildHilbertOrder(generatedCoordinates);
+    permutation.permuteCoordinates(generatedCoordinates, m_coordinates);
+
+    m_candidateLists.buildNearestNeighbors(m_coordinates, CandidateLists::DEFAULT_NUMBER_OF_NEIGHBORS, std::thread::hardware_concurrency());
+
+    m_visualization.reset(numberOfPoints, glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 1.0f));
 }
 
 void TravelingSalesmanSolver::startSolving()
@@ -65,7 +77,10 @@ void TravelingSalesmanSolver::_startSolving()
     m_isSolving = true;
     m_isInterrupt = false;
 
-    TravelingSalesmanAlgorithms::twoOptAlgorithm(m_timeStepMilliseconds, m_isInterrupt, m_points, m_route, m_routeLength);
+    m_route.reset(m_coordinates.size());
+
+    AnimatedVisualization visualization(m_visualization, m_timeStepMilliseconds);
+    TravelingSalesmanAlgorithms::runAlgorithm(m_selectedAlgorithm, visualization, m_isInterrupt, m_coordinates, m_candidateLists, m_route, m_routeLength);
 
     setWholeRouteColor(SolverColors::COMPLETE_COLOR);
 
@@ -74,16 +89,10 @@ void TravelingSalesmanSolver::_startSolving()
 
 void TravelingSalesmanSolver::setAllPointsColors(glm::vec3 color)
 {
-    for (Point2D& point : m_points)
-    {
-        point.setColor(color);
-    }
+    m_visualization.setAllPointColors(color);
 }
 
 void TravelingSalesmanSolver::setWholeRouteColor(glm::vec3 color)
 {
-    for (Point2D& point : m_points)
-    {
-        point.setOutgoingLineColor(color);
-    }
+    m_visualization.setAllOutgoingLineColors(color);
 }
@@ -0,0 +1,517 @@
+#include "TsplibIO.h"
+#include "MappedFile.h"
+
+#include <fstream>
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+    // Cursor over the mapped file contents, all parsing works directly on the mapped bytes
+    struct TextCursor
+    {
+        const char* current;
+        const char* end;
+
+        bool isAtEnd() const { return current >= end; };
+
+        void skipSpaces()
+        {
+            while (current < end && (*current == ' ' || *current == '\t' || *current == '\r'))
+            {
+                ++current;
+            }
+        }
+
+        void skipWhitespace()
+        {
+            while (current < end && (*current == ' ' || *current == '\t' || *current == '\r' || *current == '\n'))
+            {
+                ++current;
+            }
+        }
+
+        void skipLine()
+        {
+            while (current < end && *current != '\n')
+            {
+                ++current;
+            }
+            if (current < end)
+            {
+                ++current;
+            }
+        }
+
+        std::string readLine()
+        {
+            const char* start = current;
+            while (current < end && *current != '\n')
+            {
+                ++current;
+            }
+            const char* lineEnd = current;
+            while (lineEnd > start && (lineEnd[-1] == '\r' || lineEnd[-1] == ' ' || lineEnd[-1] == '\t'))
+            {
+                --lineEnd;
+            }
+            if (current < end)
+            {
+                ++current;
+            }
+            return std::string(start, lineEnd);
+        }
+
+        bool parseInteger(int64_t& value)
+        {
+            skipWhitespace();
+
+            bool isNegative = false;
+            if (current < end && (*current == '-' || *current == '+'))
+            {
+                isNegative = *current == '-';
+                ++current;
+            }
+            if (current >= end || *current < '0' || *current > '9')
+            {
+                return false;
+            }
+
+            int64_t result = 0;
+            while (current < end && *current >= '0' && *current <= '9')
+            {
+                result = result * 10 + (*current - '0');
+                ++current;
+            }
+
+            value = isNegative ? -result : result;
+            return true;
+        }
+
+        // Hand-rolled decimal parser: mantissa digits are accumulated in an integer and scaled once by a power of ten
+        bool parseDouble(double& value)
+        {
+            static const double POWERS_OF_TEN[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            skipWhitespace();
+
+            bool isNegative = false;
+            if (current < end && (*current == '-' || *current == '+'))
+            {
+                isNegative = *current == '-';
+                ++current;
+            }
+
+            uint64_t mantissa = 0;
+            int exponent = 0;
+            int numberOfDigits = 0;
+            bool hasDigits = false;
+
+            while (current < end && *current >= '0' && *current <= '9')
+            {
+                if (numberOfDigits < 19)
+                {
+                    mantissa = mantissa * 10 + (*current - '0');
+                    numberOfDigits += mantissa != 0;
+                }
+                else
+                {
+                    ++exponent;
+                }
+                hasDigits = true;
+                ++current;
+            }
+            if (current < end && *current == '.')
+            {
+                ++current;
+                while (current < end && *current >= '0' && *current <= '9')
+                {
+                    if (numberOfDigits < 19)
+                    {
+                        mantissa = mantissa * 10 + (*current - '0');
+                        numberOfDigits += mantissa != 0;
+                        --exponent;
+                    }
+                    hasDigits = true;
+                    ++current;
+                }
+            }
+            if (!hasDigits)
+            {
+                return false;
+            }
+            if (current < end && (*current == 'e' || *current == 'E'))
+            {
+                ++current;
+                int64_t explicitExponent = 0;
+                if (!parseInteger(explicitExponent))
+                {
+                    return false;
+                }
+                exponent += static_cast<int>(explicitExponent);
+            }
+
+            double result = static_cast<double>(mantissa);
+            while (exponent > 22)
+            {
+                result *= 1e22;
+                exponent -= 22;
+            }
+            while (exponent < -22)
+            {
+                result /= 1e22;
+                exponent += 22;
+            }
+            result = exponent >= 0 ? result * POWERS_OF_TEN[exponent] : result / POWERS_OF_TEN[-exponent];
+
+            value = isNegative ? -result : result;
+            return true;
+        }
+    };
+
+    std::string trim(const std::string& text)
+    {
+        const size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos)
+        {
+            return std::string();
+        }
+        const size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    // Splits a specification line "KEY : VALUE" into its key and value, lines without a colon are sections or EOF
+    void splitSpecification(const std::string& line, std::string& key, std::string& value)
+    {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos)
+        {
+            key = trim(line);
+            value.clear();
+            return;
+        }
+        key = trim(line.substr(0, colon));
+        value = trim(line.substr(colon + 1));
+    }
+
+    int64_t nint(double value)
+    {
+        return static_cast<int64_t>(value + 0.5);
+    }
+
+    // TSPLIB GEO coordinates are DDD.MM (degrees and minutes), converted to radians as in the TSPLIB documentation
+    double getGeoRadians(double coordinate)
+    {
+        const double PI = 3.141592;
+        const double degrees = static_cast<int64_t>(coordinate);
+        const double minutes = coordinate - degrees;
+        return PI * (degrees + 5.0 * minutes / 3.0) / 180.0;
+    }
+}
+
+bool TsplibIO::readInstance(const std::string& path, TsplibInstance& instance, std::string& error)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    TextCursor cursor{ file.getData(), file.getData() + file.getSize() };
+
+    int64_t dimension = -1;
+    bool hasEdgeWeightType = false;
+    bool hasCoordinateSection = false;
+
+    instance.name.clear();
+    instance.comment.clear();
+    instance.edgeWeightType = EUC_2D;
+
+    while (!cursor.isAtEnd())
+    {
+        cursor.skipWhitespace();
+        if (cursor.isAtEnd())
+        {
+            break;
+        }
+
+        std::string key, value;
+        splitSpecification(cursor.readLine(), key, value);
+
+        if (key == "NAME")
+        {
+            instance.name = value;
+        }
+        else if (key == "COMMENT")
+        {
+            instance.comment = instance.comment.empty() ? value : instance.comment + " " + value;
+        }
+        else if (key == "TYPE")
+        {
+            if (value != "TSP")
+            {
+                error = "unsupported problem type " + value;
+                return false;
+            }
+        }
+        else if (key == "DIMENSION")
+        {
+            dimension = std::atoll(value.c_str());
+        }
+        else if (key == "EDGE_WEIGHT_TYPE")
+        {
+            if (!parseEdgeWeightType(value, instance.edgeWeightType))
+            {
+                error = "unsupported edge weight type " + value;
+                return false;
+            }
+            hasEdgeWeightType = true;
+        }
+        else if (key == "NODE_COORD_TYPE" || key == "DISPLAY_DATA_TYPE")
+        {
+            continue;
+        }
+        else if (key == "NODE_COORD_SECTION")
+        {
+            hasCoordinateSection = true;
+            break;
+        }
+        else if (key == "EOF")
+        {
+            break;
+        }
+        else
+        {
+            error = "unsupported specification or section " + key;
+            return false;
+        }
+    }
+
+    if (!hasCoordinateSection)
+    {
+        error = "missing NODE_COORD_SECTION";
+        return false;
+    }
+    if (!hasEdgeWeightType)
+    {
+        error = "missing EDGE_WEIGHT_TYPE";
+        return false;
+    }
+    if (dimension <= 0 || dimension > UINT32_MAX)
+    {
+        error = "missing or invalid DIMENSION";
+        return false;
+    }
+
+    const uint32_t numberOfCities = static_cast<uint32_t>(dimension);
+    std::vector<bool> isRead(numberOfCities, false);
+
+    instance.resize(numberOfCities);
+
+    for (uint32_t i = 0; i < numberOfCities; ++i)
+    {
+        int64_t id;
+        double x, y;
+        if (!cursor.parseInteger(id) || !cursor.parseDouble(x) || !cursor.parseDouble(y))
+        {
+            error = "malformed NODE_COORD_SECTION entry " + std::to_string(i + 1);
+            return false;
+        }
+        if (id < 1 || id > dimension || isRead[id - 1])
+        {
+            error = "invalid or repeated node id " + std::to_string(id);
+            return false;
+        }
+
+        isRead[id - 1] = true;
+        instance.setCity(static_cast<uint32_t>(id - 1), x, y);
+        cursor.skipSpaces();
+    }
+
+    return true;
+}
+
+bool TsplibIO::readTour(const std::string& path, uint32_t numberOfCities, Route& route, std::string& error)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    TextCursor cursor{ file.getData(), file.getData() + file.getSize() };
+
+    bool hasTourSection = false;
+    while (!cursor.isAtEnd())
+    {
+        cursor.skipWhitespace();
+        if (cursor.isAtEnd())
+        {
+            break;
+        }
+
+        std::string key, value;
+        splitSpecification(cursor.readLine(), key, value);
+
+        if (key == "TOUR_SECTION")
+        {
+            hasTourSection = true;
+            break;
+        }
+        if (key == "DIMENSION" && std::atoll(value.c_str()) != numberOfCities)
+        {
+            error = "tour dimension " + value + " does not match the instance";
+            return false;
+        }
+        if (key == "TYPE" && value != "TOUR")
+        {
+            error = "unsupported file type " + value;
+            return false;
+        }
+    }
+
+    if (!hasTourSection)
+    {
+        error = "missing TOUR_SECTION";
+        return false;
+    }
+
+    route.reset(numberOfCities);
+
+    int64_t id;
+    while (cursor.parseInteger(id) && id != -1)
+    {
+        if (id < 1 || id > numberOfCities || route.contains(static_cast<uint32_t>(id - 1)))
+        {
+            error = "invalid or repeated node id " + std::to_string(id);
+            return false;
+        }
+        route.append(static_cast<uint32_t>(id - 1));
+    }
+
+    if (!route.isComplete())
+    {
+        error = "tour visits " + std::to_string(route.size()) + " of " + std::to_string(numberOfCities) + " cities";
+        return false;
+    }
+
+    return true;
+}
+
+bool TsplibIO::writeTour(const std::string& path, const std::string& name, const Route& route, int64_t routeLength)
+{
+    std::string contents;
+    contents.reserve(64 + static_cast<size_t>(route.size()) * 9);
+
+    contents += "NAME : " + name + ".tour\n";
+    contents += "COMMENT : Length " + std::to_string(routeLength) + "\n";
+    contents += "TYPE : TOUR\n";
+    contents += "DIMENSION : " + std::to_string(route.size()) + "\n";
+    contents += "TOUR_SECTION\n";
+
+    char number[16];
+    for (uint32_t city : route.getCities())
+    {
+        const std::to_chars_result result = std::to_chars(number, number + sizeof(number), city + 1);
+        contents.append(number, result.ptr);
+        contents += '\n';
+    }
+
+    contents += "-1\nEOF\n";
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(contents.data(), contents.size());
+
+    return static_cast<bool>(file);
+}
+
+int64_t TsplibIO::getDistance(const TsplibInstance& instance, uint32_t firstCity, uint32_t secondCity)
+{
+    const double dx = instance.xs[firstCity] - instance.xs[secondCity];
+    const double dy = instance.ys[firstCity] - instance.ys[secondCity];
+
+    switch (instance.edgeWeightType)
+    {
+    case EUC_2D:
+        return nint(std::sqrt(dx * dx + dy * dy));
+    case CEIL_2D:
+        return static_cast<int64_t>(std::ceil(std::sqrt(dx * dx + dy * dy)));
+    case ATT:
+    {
+        const double pseudoEuclideanDistance = std::sqrt((dx * dx + dy * dy) / 10.0);
+        const int64_t roundedDistance = nint(pseudoEuclideanDistance);
+        return roundedDistance < pseudoEuclideanDistance ? roundedDistance + 1 : roundedDistance;
+    }
+    case GEO:
+    {
+        const double EARTH_RADIUS = 6378.388;
+        const double firstLatitude = getGeoRadians(instance.xs[firstCity]);
+        const double firstLongitude = getGeoRadians(instance.ys[firstCity]);
+        const double secondLatitude = getGeoRadians(instance.xs[secondCity]);
+        const double secondLongitude = getGeoRadians(instance.ys[secondCity]);
+
+        const double q1 = std::cos(firstLongitude - secondLongitude);
+        const double q2 = std::cos(firstLatitude - secondLatitude);
+        const double q3 = std::cos(firstLatitude + secondLatitude);
+        return static_cast<int64_t>(EARTH_RADIUS * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+    }
+
+    return 0;
+}
+
+int64_t TsplibIO::getRouteLength(const TsplibInstance& instance, const Route& route)
+{
+    int64_t routeLength = 0;
+    for (uint32_t i = 0; i < route.size(); ++i)
+    {
+        routeLength += getDistance(instance, route.at(i), route.at(i + 1 == route.size() ? 0 : i + 1));
+    }
+    return routeLength;
+}
+
+bool TsplibIO::parseEdgeWeightType(const std::string& name, EdgeWeightType& edgeWeightType)
+{
+    if (name == "EUC_2D")
+    {
+        edgeWeightType = EUC_2D;
+    }
+    else if (name == "CEIL_2D")
+    {
+        edgeWeightType = CEIL_2D;
+    }
+    else if (name == "ATT")
+    {
+        edgeWeightType = ATT;
+    }
+    else if (name == "GEO")
+    {
+        edgeWeightType = GEO;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+const char* TsplibIO::getEdgeWeightTypeName(EdgeWeightType edgeWeightType)
+{
+    switch (edgeWeightType)
+    {
+    case EUC_2D:
+        return "EUC_2D";
+    case CEIL_2D:
+        return "CEIL_2D";
+    case ATT:
+        return "ATT";
+    case GEO:
+        return "GEO";
+    }
+    return "UNKNOWN";
+}
@@ -0,0 +1,183 @@
+#include "TwoLevelTour.h"
+
+#include <algorithm>
+#include <cmath>
+
+void TwoLevelTour::build(const Route& route)
+{
+    m_numberOfCities = route.size();
+    m_groupSize = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(m_numberOfCities)))));
+
+    // Every flip adds at most two segments, regrouping keeps their number below twice the initial one
+    const uint32_t numberOfGroups = (m_numberOfCities + m_groupSize - 1) / m_groupSize;
+    m_maxNumberOfSegments = 2 * numberOfGroups + 2;
+
+    m_slots.resize(static_cast<size_t>(m_maxNumberOfSegments) * m_groupSize);
+    m_segments.resize(m_maxNumberOfSegments);
+    m_segmentOf.resize(m_numberOfCities);
+    m_slotIndexOf.resize(m_numberOfCities);
+
+    m_sequence = route.getCities();
+    regroup();
+}
+
+void TwoLevelTour::writeTo(Route& route) const
+{
+    route.reset(m_numberOfCities);
+    for (uint32_t segment : m_order)
+    {
+        for (uint32_t i = 0; i < m_segments[segment].size; ++i)
+        {
+            route.append(getCity(segment, i));
+        }
+    }
+}
+
+void TwoLevelTour::regroup()
+{
+    m_order.clear();
+    m_freeSegments.clear();
+
+    for (uint32_t begin = 0, segment = 0; begin < m_numberOfCities; begin += m_groupSize, ++segment)
+    {
+        const uint32_t size = std::min(m_groupSize, m_numberOfCities - begin);
+        m_segments[segment] = { size, segment, false };
+        m_order.push_back(segment);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const uint32_t city = m_sequence[begin + i];
+            m_slots[segment * m_groupSize + i] = city;
+            m_segmentOf[city] = segment;
+            m_slotIndexOf[city] = i;
+        }
+    }
+
+    for (uint32_t segment = m_maxNumberOfSegments; segment-- > m_order.size();)
+    {
+        m_freeSegments.push_back(segment);
+    }
+}
+
+void TwoLevelTour::splitSegment(uint32_t segment, uint32_t index)
+{
+    const uint32_t newSegment = m_freeSegments.back();
+    m_freeSegments.pop_back();
+
+    Segment& data = m_segments[segment];
+    const uint32_t tailSize = data.size - index;
+    uint32_t* slots = &m_slots[segment * m_groupSize];
+    uint32_t* newSlots = &m_slots[newSegment * m_groupSize];
+
+    // The tail keeps its storage order and reversal bit, in a reversed segment it is stored at the front
+    const uint32_t tailBegin = data.isReversed ? 0 : index;
+    std::copy(slots + tailBegin, slots + tailBegin + tailSize, newSlots);
+    if (data.isReversed)
+    {
+        std::copy(slots + tailSize, slots + data.size, slots);
+        for (uint32_t i = 0; i < index; ++i)
+        {
+            m_slotIndexOf[slots[i]] = i;
+        }
+    }
+
+    for (uint32_t i = 0; i < tailSize; ++i)
+    {
+        m_segmentOf[newSlots[i]] = newSegment;
+        m_slotIndexOf[newSlots[i]] = i;
+    }
+
+    data.size = index;
+    m_segments[newSegment] = { tailSize, data.rank + 1, data.isReversed };
+
+    m_order.insert(m_order.begin() + data.rank + 1, newSegment);
+    for (uint32_t rank = data.rank + 2; rank < m_order.size(); ++rank)
+    {
+        m_segments[m_order[rank]].rank = rank;
+    }
+}
+
+void TwoLevelTour::reverseInsideSegment(uint32_t segment, uint32_t firstIndex, uint32_t lastIndex)
+{
+    const Segment& data = m_segments[segment];
+    uint32_t* slots = &m_slots[segment * m_groupSize];
+
+    const uint32_t firstSlot = data.isReversed ? data.size - 1 - lastIndex : firstIndex;
+    const uint32_t lastSlot = data.isReversed ? data.size - 1 - firstIndex : lastIndex;
+
+    std::reverse(slots + firstSlot, slots + lastSlot + 1);
+    for (uint32_t i = firstSlot; i <= lastSlot; ++i)
+    {
+        m_slotIndexOf[slots[i]] = i;
+    }
+}
+
+void TwoLevelTour::reverseSegments(uint32_t firstRank, uint32_t count)
+{
+    const uint32_t numberOfSegments = m_order.size();
+    auto wrap = [numberOfSegments](uint32_t rank) { return rank >= numberOfSegments ? rank - numberOfSegments : rank; };
+
+    for (uint32_t i = 0; i < count / 2; ++i)
+    {
+        std::swap(m_order[wrap(firstRank + i)], m_order[wrap(firstRank + count - 1 - i)]);
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t rank = wrap(firstRank + i);
+        Segment& segment = m_segments[m_order[rank]];
+        segment.rank = rank;
+        segment.isReversed = !segment.isReversed;
+    }
+}
+
+void TwoLevelTour::flip(uint32_t first, uint32_t last)
+{
+    if (first == last)
+    {
+        return;
+    }
+
+    if (m_segmentOf[first] == m_segmentOf[last] && getIndexInSegment(first) <= getIndexInSegment(last))
+    {
+        reverseInsideSegment(m_segmentOf[first], getIndexInSegment(first), getIndexInSegment(last));
+        return;
+    }
+
+    if (m_order.size() + 2 > m_maxNumberOfSegments)
+    {
+        m_sequence.clear();
+        for (uint32_t segment : m_order)
+        {
+            for (uint32_t i = 0; i < m_segments[segment].size; ++i)
+            {
+                m_sequence.push_back(getCity(segment, i));
+            }
+        }
+        regroup();
+    }
+
+    // Make the path start and end at segment boundaries
+    if (getIndexInSegment(first) > 0)
+    {
+        splitSegment(m_segmentOf[first], getIndexInSegment(first));
+    }
+    if (getIndexInSegment(last) + 1 < m_segments[m_segmentOf[last]].size)
+    {
+        splitSegment(m_segmentOf[last], getIndexInSegment(last) + 1);
+    }
+
+    const uint32_t numberOfSegments = m_order.size();
+    const uint32_t firstRank = m_segments[m_segmentOf[first]].rank;
+    const uint32_t lastRank = m_segments[m_segmentOf[last]].rank;
+    const uint32_t count = (lastRank + numberOfSegments - firstRank) % numberOfSegments + 1;
+
+    if (2 * count <= numberOfSegments)
+    {
+        reverseSegments(firstRank, count);
+    }
+    else
+    {
+        reverseSegments(lastRank + 1 == numberOfSegments ? 0 : lastRank + 1, numberOfSegments - count);
+    }
+}
@@ -0,0 +1,267 @@
+#include "TwoOptKernel.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#if defined(SIMD_KERNELS_X86)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Everything a kernel needs to score second edges: value(j) = d(a, j) + d(b, j + 1) - d(j, j + 1).
+    // The route length change is value(j) - d(a, b), the constant term is left out of the scan.
+    // Scales a Euclidean distance to the pseudo-Euclidean r of the ATT edge weight
+    constexpr float PSEUDO_EUCLIDEAN_SCALE = 0.316227766f;
+
+    struct KernelInput
+    {
+        const float* xs;
+        const float* ys;
+        const float* edgeLengths;
+        float ax;
+        float ay;
+        float bx;
+        float by;
+        DistanceMode distanceMode;
+    };
+
+    float roundDistance(float distance, DistanceMode distanceMode)
+    {
+        switch (distanceMode)
+        {
+        case ROUNDED_EUCLIDEAN:
+            return std::floor(distance + 0.5f);
+        case CEILED_EUCLIDEAN:
+            return std::ceil(distance);
+        case PSEUDO_EUCLIDEAN:
+            return std::ceil(distance * PSEUDO_EUCLIDEAN_SCALE);
+        default:
+            return distance;
+        }
+    }
+
+    TwoOptKernel::Move findBestMoveScalar(const KernelInput& input, uint32_t begin, uint32_t end)
+    {
+        TwoOptKernel::Move best = { std::numeric_limits<float>::infinity(), begin };
+        for (uint32_t j = begin; j < end; ++j)
+        {
+            const float dxA = input.ax - input.xs[j];
+            const float dyA = input.ay - input.ys[j];
+            const float dxB = input.bx - input.xs[j + 1];
+            const float dyB = input.by - input.ys[j + 1];
+            const float value = roundDistance(std::sqrt(dxA * dxA + dyA * dyA), input.distanceMode)
+                + roundDistance(std::sqrt(dxB * dxB + dyB * dyB), input.distanceMode) - input.edgeLengths[j];
+            if (value < best.delta)
+            {
+                best = { value, j };
+            }
+        }
+        return best;
+    }
+
+    // Reduces the per-lane minima, ties going to the lower position like in the scalar scan
+    TwoOptKernel::Move reduceLanes(const float* values, const int32_t* positions, uint32_t numberOfLanes, TwoOptKernel::Move best)
+    {
+        for (uint32_t lane = 0; lane < numberOfLanes; ++lane)
+        {
+            if (positions[lane] < 0)
+            {
+                continue;
+            }
+            const uint32_t position = static_cast<uint32_t>(positions[lane]);
+            if (values[lane] < best.delta || (values[lane] == best.delta && position < best.secondPosition))
+            {
+                best = { values[lane], position };
+            }
+        }
+        return best;
+    }
+
+#if defined(SIMD_KERNELS_X86)
+    SIMD_TARGET_SSE41 __m128 roundDistancesSse41(__m128 distances, DistanceMode distanceMode)
+    {
+        switch (distanceMode)
+        {
+        case ROUNDED_EUCLIDEAN:
+            return _mm_floor_ps(_mm_add_ps(distances, _mm_set1_ps(0.5f)));
+        case CEILED_EUCLIDEAN:
+            return _mm_ceil_ps(distances);
+        case PSEUDO_EUCLIDEAN:
+            return _mm_ceil_ps(_mm_mul_ps(distances, _mm_set1_ps(PSEUDO_EUCLIDEAN_SCALE)));
+        default:
+            return distances;
+        }
+    }
+
+    SIMD_TARGET_SSE41 TwoOptKernel::Move findBestMoveSse41(const KernelInput& input, uint32_t begin, uint32_t end)
+    {
+        constexpr uint32_t NUMBER_OF_LANES = 4;
+
+        const __m128 ax = _mm_set1_ps(input.ax);
+        const __m128 ay = _mm_set1_ps(input.ay);
+        const __m128 bx = _mm_set1_ps(input.bx);
+        const __m128 by = _mm_set1_ps(input.by);
+
+        __m128 bestValues = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        __m128i bestPositions = _mm_set1_epi32(-1);
+        __m128i positions = _mm_add_epi32(_mm_set1_epi32(static_cast<int32_t>(begin)), _mm_setr_epi32(0, 1, 2, 3));
+        const __m128i positionStep = _mm_set1_epi32(NUMBER_OF_LANES);
+
+        uint32_t j = begin;
+        for (; j + NUMBER_OF_LANES <= end; j += NUMBER_OF_LANES)
+        {
+            const __m128 dxA = _mm_sub_ps(ax, _mm_loadu_ps(input.xs + j));
+            const __m128 dyA = _mm_sub_ps(ay, _mm_loadu_ps(input.ys + j));
+            const __m128 dxB = _mm_sub_ps(bx, _mm_loadu_ps(input.xs + j + 1));
+            const __m128 dyB = _mm_sub_ps(by, _mm_loadu_ps(input.ys + j + 1));
+            const __m128 distanceA = roundDistancesSse41(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dxA, dxA), _mm_mul_ps(dyA, dyA))), input.distanceMode);
+            const __m128 distanceB = roundDistancesSse41(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dxB, dxB), _mm_mul_ps(dyB, dyB))), input.distanceMode);
+            const __m128 values = _mm_sub_ps(_mm_add_ps(distanceA, distanceB), _mm_loadu_ps(input.edgeLengths + j));
+
+            const __m128 isBetter = _mm_cmplt_ps(values, bestValues);
+            bestValues = _mm_blendv_ps(bestValues, values, isBetter);
+            bestPositions = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(bestPositions), _mm_castsi128_ps(positions), isBetter));
+            positions = _mm_add_epi32(positions, positionStep);
+        }
+
+        alignas(16) float laneValues[NUMBER_OF_LANES];
+        alignas(16) int32_t lanePositions[NUMBER_OF_LANES];
+        _mm_store_ps(laneValues, bestValues);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanePositions), bestPositions);
+
+        return reduceLanes(laneValues, lanePositions, NUMBER_OF_LANES, findBestMoveScalar(input, j, end));
+    }
+
+    SIMD_TARGET_AVX2 __m256 roundDistancesAvx2(__m256 distances, DistanceMode distanceMode)
+    {
+        switch (distanceMode)
+        {
+        case ROUNDED_EUCLIDEAN:
+            return _mm256_floor_ps(_mm256_add_ps(distances, _mm256_set1_ps(0.5f)));
+        case CEILED_EUCLIDEAN:
+            return _mm256_ceil_ps(distances);
+        case PSEUDO_EUCLIDEAN:
+            return _mm256_ceil_ps(_mm256_mul_ps(distances, _mm256_set1_ps(PSEUDO_EUCLIDEAN_SCALE)));
+        default:
+            return distances;
+        }
+    }
+
+    SIMD_TARGET_AVX2 TwoOptKernel::Move findBestMoveAvx2(const KernelInput& input, uint32_t begin, uint32_t end)
+    {
+        constexpr uint32_t NUMBER_OF_LANES = 8;
+
+        const __m256 ax = _mm256_set1_ps(input.ax);
+        const __m256 ay = _mm256_set1_ps(input.ay);
+        const __m256 bx = _mm256_set1_ps(input.bx);
+        const __m256 by = _mm256_set1_ps(input.by);
+
+        __m256 bestValues = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        __m256i bestPositions = _mm256_set1_epi32(-1);
+        __m256i positions = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32_t>(begin)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        const __m256i positionStep = _mm256_set1_epi32(NUMBER_OF_LANES);
+
+        uint32_t j = begin;
+        for (; j + NUMBER_OF_LANES <= end; j += NUMBER_OF_LANES)
+        {
+            const __m256 dxA = _mm256_sub_ps(ax, _mm256_loadu_ps(input.xs + j));
+            const __m256 dyA = _mm256_sub_ps(ay, _mm256_loadu_ps(input.ys + j));
+            const __m256 dxB = _mm256_sub_ps(bx, _mm256_loadu_ps(input.xs + j + 1));
+            const __m256 dyB = _mm256_sub_ps(by, _mm256_loadu_ps(input.ys + j + 1));
+            const __m256 distanceA = roundDistancesAvx2(_mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dxA, dxA), _mm256_mul_ps(dyA, dyA))), input.distanceMode);
+            const __m256 distanceB = roundDistancesAvx2(_mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dxB, dxB), _mm256_mul_ps(dyB, dyB))), input.distanceMode);
+            const __m256 values = _mm256_sub_ps(_mm256_add_ps(distanceA, distanceB), _mm256_loadu_ps(input.edgeLengths + j));
+
+            const __m256 isBetter = _mm256_cmp_ps(values, bestValues, _CMP_LT_OQ);
+            bestValues = _mm256_blendv_ps(bestValues, values, isBetter);
+            bestPositions = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestPositions), _mm256_castsi256_ps(positions), isBetter));
+            positions = _mm256_add_epi32(positions, positionStep);
+        }
+
+        alignas(32) float laneValues[NUMBER_OF_LANES];
+        alignas(32) int32_t lanePositions[NUMBER_OF_LANES];
+        _mm256_store_ps(laneValues, bestValues);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanePositions), bestPositions);
+
+        return reduceLanes(laneValues, lanePositions, NUMBER_OF_LANES, findBestMoveScalar(input, j, end));
+    }
+#endif
+}
+
+void TwoOptKernel::setInstructionSet(InstructionSet instructionSet)
+{
+    m_instructionSet = std::min(instructionSet, CpuFeatures::getInstructionSet());
+}
+
+void TwoOptKernel::gather(const CityCoordinates& coordinates, const Route& route)
+{
+    m_numberOfCities = route.size();
+    m_distanceMode = coordinates.getDistanceMode();
+
+    m_xs.resize(m_numberOfCities + 1);
+    m_ys.resize(m_numberOfCities + 1);
+    m_edgeLengths.resize(m_numberOfCities);
+
+    for (uint32_t position = 0; position < m_numberOfCities; ++position)
+    {
+        gatherPosition(coordinates, route, position);
+    }
+}
+
+void TwoOptKernel::update(const CityCoordinates& coordinates, const Route& route, uint32_t firstPosition, uint32_t lastPosition)
+{
+    // The edge entering the range changed too
+    const uint32_t count = (lastPosition + m_numberOfCities - firstPosition) % m_numberOfCities + 2;
+    uint32_t position = firstPosition == 0 ? m_numberOfCities - 1 : firstPosition - 1;
+    for (uint32_t i = 0; i < std::min(count, m_numberOfCities); ++i)
+    {
+        gatherPosition(coordinates, route, position);
+        position = position + 1 == m_numberOfCities ? 0 : position + 1;
+    }
+}
+
+void TwoOptKernel::gatherPosition(const CityCoordinates& coordinates, const Route& route, uint32_t position)
+{
+    const uint32_t city = route.at(position);
+    m_xs[position] = coordinates.getX(city);
+    m_ys[position] = coordinates.getY(city);
+    if (position == 0)
+    {
+        m_xs[m_numberOfCities] = m_xs[0];
+        m_ys[m_numberOfCities] = m_ys[0];
+    }
+    m_edgeLengths[position] = coordinates.getDistance(city, route.at(position + 1 == m_numberOfCities ? 0 : position + 1));
+}
+
+TwoOptKernel::Move TwoOptKernel::findBestMove(uint32_t firstPosition, uint32_t begin, uint32_t end) const
+{
+    if (begin >= end)
+    {
+        return { std::numeric_limits<float>::infinity(), begin };
+    }
+
+    const uint32_t nextPosition = firstPosition + 1;
+    const KernelInput input = { m_xs.data(), m_ys.data(), m_edgeLengths.data(), m_xs[firstPosition], m_ys[firstPosition],
+        m_xs[nextPosition], m_ys[nextPosition], m_distanceMode };
+
+    Move best;
+    switch (m_instructionSet)
+    {
+#if defined(SIMD_KERNELS_X86)
+    case AVX2:
+        best = findBestMoveAvx2(input, begin, end);
+        break;
+    case SSE41:
+        best = findBestMoveSse41(input, begin, end);
+        break;
+#endif
+    default:
+        best = findBestMoveScalar(input, begin, end);
+        break;
+    }
+
+    best.delta -= m_edgeLengths[firstPosition];
+    return best;
+}
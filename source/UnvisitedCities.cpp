@@ -0,0 +1,175 @@
+#include "UnvisitedCities.h"
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+#if defined(SIMD_KERNELS_X86)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    struct NearestIndex
+    {
+        float squaredDistance;
+        uint32_t index;
+    };
+
+    NearestIndex findNearestScalar(const float* xs, const float* ys, uint32_t begin, uint32_t end, float x, float y)
+    {
+        NearestIndex nearest = { std::numeric_limits<float>::infinity(), UnvisitedCities::INVALID_CITY };
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const float dx = xs[i] - x;
+            const float dy = ys[i] - y;
+            const float squaredDistance = dx * dx + dy * dy;
+            if (squaredDistance < nearest.squaredDistance)
+            {
+                nearest = { squaredDistance, i };
+            }
+        }
+        return nearest;
+    }
+
+    // Reduces the per-lane minima, ties going to the lower index like in the scalar scan
+    NearestIndex reduceLanes(const float* squaredDistances, const int32_t* indices, uint32_t numberOfLanes, NearestIndex nearest)
+    {
+        for (uint32_t lane = 0; lane < numberOfLanes; ++lane)
+        {
+            if (indices[lane] < 0)
+            {
+                continue;
+            }
+            const uint32_t index = static_cast<uint32_t>(indices[lane]);
+            if (squaredDistances[lane] < nearest.squaredDistance || (squaredDistances[lane] == nearest.squaredDistance && index < nearest.index))
+            {
+                nearest = { squaredDistances[lane], index };
+            }
+        }
+        return nearest;
+    }
+
+#if defined(SIMD_KERNELS_X86)
+    SIMD_TARGET_SSE41 NearestIndex findNearestSse41(const float* xs, const float* ys, uint32_t size, float x, float y)
+    {
+        constexpr uint32_t NUMBER_OF_LANES = 4;
+
+        const __m128 queryX = _mm_set1_ps(x);
+        const __m128 queryY = _mm_set1_ps(y);
+
+        __m128 bestSquaredDistances = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        __m128i bestIndices = _mm_set1_epi32(-1);
+        __m128i indices = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i indexStep = _mm_set1_epi32(NUMBER_OF_LANES);
+
+        uint32_t i = 0;
+        for (; i + NUMBER_OF_LANES <= size; i += NUMBER_OF_LANES)
+        {
+            const __m128 dx = _mm_sub_ps(_mm_load_ps(xs + i), queryX);
+            const __m128 dy = _mm_sub_ps(_mm_load_ps(ys + i), queryY);
+            const __m128 squaredDistances = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+            const __m128 isCloser = _mm_cmplt_ps(squaredDistances, bestSquaredDistances);
+            bestSquaredDistances = _mm_blendv_ps(bestSquaredDistances, squaredDistances, isCloser);
+            bestIndices = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(bestIndices), _mm_castsi128_ps(indices), isCloser));
+            indices = _mm_add_epi32(indices, indexStep);
+        }
+
+        alignas(16) float laneSquaredDistances[NUMBER_OF_LANES];
+        alignas(16) int32_t laneIndices[NUMBER_OF_LANES];
+        _mm_store_ps(laneSquaredDistances, bestSquaredDistances);
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneIndices), bestIndices);
+
+        return reduceLanes(laneSquaredDistances, laneIndices, NUMBER_OF_LANES, findNearestScalar(xs, ys, i, size, x, y));
+    }
+
+    SIMD_TARGET_AVX2 NearestIndex findNearestAvx2(const float* xs, const float* ys, uint32_t size, float x, float y)
+    {
+        constexpr uint32_t NUMBER_OF_LANES = 8;
+
+        const __m256 queryX = _mm256_set1_ps(x);
+        const __m256 queryY = _mm256_set1_ps(y);
+
+        __m256 bestSquaredDistances = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        __m256i bestIndices = _mm256_set1_epi32(-1);
+        __m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i indexStep = _mm256_set1_epi32(NUMBER_OF_LANES);
+
+        uint32_t i = 0;
+        for (; i + NUMBER_OF_LANES <= size; i += NUMBER_OF_LANES)
+        {
+            const __m256 dx = _mm256_sub_ps(_mm256_load_ps(xs + i), queryX);
+            const __m256 dy = _mm256_sub_ps(_mm256_load_ps(ys + i), queryY);
+            const __m256 squaredDistances = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+            const __m256 isCloser = _mm256_cmp_ps(squaredDistances, bestSquaredDistances, _CMP_LT_OQ);
+            bestSquaredDistances = _mm256_blendv_ps(bestSquaredDistances, squaredDistances, isCloser);
+            bestIndices = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIndices), _mm256_castsi256_ps(indices), isCloser));
+            indices = _mm256_add_epi32(indices, indexStep);
+        }
+
+        alignas(32) float laneSquaredDistances[NUMBER_OF_LANES];
+        alignas(32) int32_t laneIndices[NUMBER_OF_LANES];
+        _mm256_store_ps(laneSquaredDistances, bestSquaredDistances);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(laneIndices), bestIndices);
+
+        return reduceLanes(laneSquaredDistances, laneIndices, NUMBER_OF_LANES, findNearestScalar(xs, ys, i, size, x, y));
+    }
+#endif
+}
+
+void UnvisitedCities::reset(const CityCoordinates& coordinates)
+{
+    const uint32_t numberOfCities = coordinates.size();
+
+    m_cities.resize(numberOfCities);
+    std::iota(m_cities.begin(), m_cities.end(), 0);
+    m_indices = m_cities;
+
+    m_xs.assign(coordinates.getXs(), coordinates.getXs() + numberOfCities);
+    m_ys.assign(coordinates.getYs(), coordinates.getYs() + numberOfCities);
+}
+
+void UnvisitedCities::remove(uint32_t city)
+{
+    const uint32_t index = m_indices[city];
+    const uint32_t lastIndex = m_cities.size() - 1;
+    const uint32_t lastCity = m_cities[lastIndex];
+
+    m_cities[index] = lastCity;
+    m_xs[index] = m_xs[lastIndex];
+    m_ys[index] = m_ys[lastIndex];
+    m_indices[lastCity] = index;
+    m_indices[city] = INVALID_CITY;
+
+    m_cities.pop_back();
+    m_xs.pop_back();
+    m_ys.pop_back();
+}
+
+void UnvisitedCities::setInstructionSet(InstructionSet instructionSet)
+{
+    m_instructionSet = std::min(instructionSet, CpuFeatures::getInstructionSet());
+}
+
+uint32_t UnvisitedCities::findNearest(float x, float y) const
+{
+    NearestIndex nearest;
+    switch (m_instructionSet)
+    {
+#if defined(SIMD_KERNELS_X86)
+    case AVX2:
+        nearest = findNearestAvx2(m_xs.data(), m_ys.data(), size(), x, y);
+        break;
+    case SSE41:
+        nearest = findNearestSse41(m_xs.data(), m_ys.data(), size(), x, y);
+        break;
+#endif
+    default:
+        nearest = findNearestScalar(m_xs.data(), m_ys.data(), 0, size(), x, y);
+        break;
+    }
+
+    return nearest.index == INVALID_CITY ? INVALID_CITY : m_cities[nearest.index];
+}
@@ -0,0 +1,19 @@
+#include "VisualizationBuffer.h"
+
+#include <algorithm>
+
+void VisualizationBuffer::reset(uint32_t numberOfCities, glm::vec3 pointColor, glm::vec3 outgoingLineColor)
+{
+    m_pointColors.assign(numberOfCities, pointColor);
+    m_outgoingLineColors.assign(numberOfCities, outgoingLineColor);
+}
+
+void VisualizationBuffer::setAllPointColors(glm::vec3 color)
+{
+    std::fill(m_pointColors.begin(), m_pointColors.end(), color);
+}
+
+void VisualizationBuffer::setAllOutgoingLineColors(glm::vec3 color)
+{
+    std::fill(m_outgoingLineColors.begin(), m_outgoingLineColors.end(), color);
+}